@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <eventcpp/event.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    class Handler
+    {
+    public:
+        int total = 0;
+
+        void Member(int x)
+        {
+            total += x;
+        }
+    };
+
+    void BM_StdFunctionAttachErase(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        std::vector<std::function<void (int)>> subscribers;
+
+        for (auto _ : state)
+        {
+            for (auto& h : handlers)
+            {
+                subscribers.emplace_back([&h](int x) { h.Member(x); });
+            }
+
+            while (!subscribers.empty())
+            {
+                subscribers.erase(subscribers.begin());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_AttachDetachByHandle(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        std::vector<event::subscription> handles(handlers.size());
+        event::event<void (int)> e;
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < handlers.size(); i++)
+            {
+                handles[i] = e.attach(&Handler::Member, handlers[i]);
+            }
+
+            for (auto handle : handles)
+            {
+                e.detach(handle);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_AttachDetachByCallback(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::event<void (int)> e;
+
+        for (auto _ : state)
+        {
+            for (auto& h : handlers)
+            {
+                e.attach(&Handler::Member, h);
+            }
+
+            for (auto& h : handlers)
+            {
+                e.detach(&Handler::Member, h);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_AttachDetachWithPriority(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        std::vector<event::subscription> handles(handlers.size());
+        event::event<void (int)> e;
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < handlers.size(); i++)
+            {
+                handles[i] = e.attach(&Handler::Member, handlers[i], static_cast<int>(i % 4));
+            }
+
+            for (auto handle : handles)
+            {
+                e.detach(handle);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_StdFunctionAttachErase)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_AttachDetachByHandle)->Arg(1)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_AttachDetachByCallback)->Arg(1)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_AttachDetachWithPriority)->Arg(1)->Arg(10)->Arg(1000);
@@ -0,0 +1,242 @@
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <eventcpp/event.hpp>
+#include <eventcpp/concurrent_event.hpp>
+#include <eventcpp/executor.hpp>
+#include <eventcpp/queued_event.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    constexpr int subscribers = 10;
+
+    class Handler
+    {
+    public:
+        std::atomic<int> total{0};
+
+        void Member(int x)
+        {
+            total.fetch_add(x, std::memory_order_relaxed);
+        }
+    };
+
+    Handler handlers[subscribers];
+
+    event::concurrent_event<void (int)> shared_concurrent;
+    event::event<void (int)> shared_locked;
+    std::mutex shared_lock;
+
+    void BM_ConcurrentEventFire(benchmark::State& state)
+    {
+        if (state.thread_index() == 0)
+        {
+            for (auto& h : handlers)
+            {
+                shared_concurrent.attach(&Handler::Member, h);
+            }
+        }
+
+        for (auto _ : state)
+        {
+            shared_concurrent(1);
+        }
+
+        if (state.thread_index() == 0)
+        {
+            for (auto& h : handlers)
+            {
+                shared_concurrent.detach(&Handler::Member, h);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * subscribers);
+    }
+
+    void BM_ConcurrentEventFireWhileAttaching(benchmark::State& state)
+    {
+        if (state.thread_index() == 0)
+        {
+            for (auto& h : handlers)
+            {
+                shared_concurrent.attach(&Handler::Member, h);
+            }
+        }
+
+        Handler churn;
+
+        for (auto _ : state)
+        {
+            if (state.thread_index() == 0)
+            {
+                auto handle = shared_concurrent.attach(&Handler::Member, churn);
+                shared_concurrent.detach(handle);
+            }
+            else
+            {
+                shared_concurrent(1);
+            }
+        }
+
+        if (state.thread_index() == 0)
+        {
+            for (auto& h : handlers)
+            {
+                shared_concurrent.detach(&Handler::Member, h);
+            }
+        }
+    }
+
+    constexpr int queued_per_producer = 100000;
+
+    /**
+     * \brief Deliver notifications enqueued by state.range(0) producer threads on the calling thread
+     */
+    template<typename TEnqueue, typename TDrain>
+    void produce_and_drain(benchmark::State& state, TEnqueue enqueue, TDrain drain)
+    {
+        auto producers = static_cast<int>(state.range(0));
+        std::int64_t total = static_cast<std::int64_t>(producers) * queued_per_producer;
+
+        for (auto _ : state)
+        {
+            std::vector<std::thread> threads;
+            std::int64_t delivered = 0;
+
+            for (int p = 0; p < producers; p++)
+            {
+                threads.emplace_back([&enqueue]
+                {
+                    for (int i = 0; i < queued_per_producer; i++)
+                    {
+                        while (!enqueue(i))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            while (delivered < total)
+            {
+                delivered += static_cast<std::int64_t>(drain());
+            }
+
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * total);
+    }
+
+    void BM_QueuedEventEnqueue(benchmark::State& state)
+    {
+        event::queued_event<void (int)> e(4096);
+        Handler h;
+
+        e.attach(&Handler::Member, h);
+
+        produce_and_drain(state,
+            [&e](int x) { return e.enqueue(x); },
+            [&e] { return e.drain(256); });
+    }
+
+    void BM_MutexDequeEnqueue(benchmark::State& state)
+    {
+        event::event<void (int)> e;
+        std::deque<int> queue;
+        std::mutex lock;
+        Handler h;
+
+        e.attach(&Handler::Member, h);
+
+        produce_and_drain(state,
+            [&](int x)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+
+                if (queue.size() >= 4096)
+                    return false;
+
+                queue.push_back(x);
+
+                return true;
+            },
+            [&]
+            {
+                std::deque<int> batch;
+
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    batch.swap(queue);
+                }
+
+                for (auto x : batch)
+                {
+                    e(x);
+                }
+
+                return batch.size();
+            });
+    }
+
+    void BM_FireParallel(benchmark::State& state)
+    {
+        std::vector<Handler> subscribers(state.range(0));
+        event::event<void (int)> e;
+
+        for (auto& h : subscribers)
+        {
+            e.attach(&Handler::Member, h);
+        }
+
+        for (auto _ : state)
+        {
+            e.fire_parallel(event::thread_pool::shared(), 1);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_MutexEventFire(benchmark::State& state)
+    {
+        if (state.thread_index() == 0)
+        {
+            for (auto& h : handlers)
+            {
+                shared_locked.attach(&Handler::Member, h);
+            }
+        }
+
+        for (auto _ : state)
+        {
+            std::lock_guard<std::mutex> lock(shared_lock);
+            shared_locked(1);
+        }
+
+        if (state.thread_index() == 0)
+        {
+            for (auto& h : handlers)
+            {
+                shared_locked.detach(&Handler::Member, h);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * subscribers);
+    }
+}
+
+BENCHMARK(BM_ConcurrentEventFire)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ConcurrentEventFireWhileAttaching)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK(BM_QueuedEventEnqueue)->Arg(1)->Arg(2)->Arg(4)->Arg(7)->UseRealTime();
+BENCHMARK(BM_MutexDequeEnqueue)->Arg(1)->Arg(2)->Arg(4)->Arg(7)->UseRealTime();
+BENCHMARK(BM_FireParallel)->Arg(1000)->Arg(10000)->Arg(100000)->UseRealTime();
+BENCHMARK(BM_MutexEventFire)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,347 @@
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <eventcpp/event.hpp>
+#include <eventcpp/instrumentation.hpp>
+#include <eventcpp/keyed_event.hpp>
+#include <eventcpp/recording.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    int sink = 0;
+
+    void Free(int x)
+    {
+        sink += x;
+    }
+
+    void FreeNoexcept(int x) noexcept
+    {
+        sink += x;
+    }
+
+    class Handler
+    {
+    public:
+        int total = 0;
+
+        static void Static(int x)
+        {
+            sink += x;
+        }
+
+        void Member(int x)
+        {
+            total += x;
+        }
+    };
+
+    /**
+     * \brief Report the time per notified subscriber next to the time per notification
+     */
+    void per_subscriber(benchmark::State& state, std::int64_t subscribers)
+    {
+        state.counters["per_subscriber"] = benchmark::Counter(static_cast<double>(subscribers),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    template<typename TEvent>
+    void notify(benchmark::State& state, TEvent& e)
+    {
+        int arg = 1;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(arg);
+            e(arg);
+            benchmark::ClobberMemory();
+        }
+
+        per_subscriber(state, state.range(0));
+    }
+
+    void BM_RawFunctionPointer(benchmark::State& state)
+    {
+        std::vector<void (*)(int)> subscribers(state.range(0), &Free);
+        int arg = 1;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(arg);
+
+            for (auto func : subscribers)
+            {
+                func(arg);
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        per_subscriber(state, state.range(0));
+    }
+
+    void BM_StdFunction(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        std::vector<std::function<void (int)>> subscribers;
+        int arg = 1;
+
+        for (auto& h : handlers)
+        {
+            subscribers.emplace_back([&h](int x) { h.Member(x); });
+        }
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(arg);
+
+            for (const auto& func : subscribers)
+            {
+                func(arg);
+            }
+
+            benchmark::ClobberMemory();
+        }
+
+        per_subscriber(state, state.range(0));
+    }
+
+    void BM_EventFree(benchmark::State& state)
+    {
+        event::event<void (int)> e;
+
+        for (std::int64_t i = 0; i < state.range(0); i++)
+        {
+            e.attach(Free);
+        }
+
+        notify(state, e);
+    }
+
+    void BM_EventStatic(benchmark::State& state)
+    {
+        event::event<void (int)> e;
+
+        for (std::int64_t i = 0; i < state.range(0); i++)
+        {
+            e.attach(&Handler::Static);
+        }
+
+        notify(state, e);
+    }
+
+    void BM_EventMember(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::event<void (int)> e;
+
+        for (auto& h : handlers)
+        {
+            e.attach(&Handler::Member, h);
+        }
+
+        notify(state, e);
+    }
+
+    void BM_EventBoundMember(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::event<void (int)> e;
+
+        for (auto& h : handlers)
+        {
+            e.attach<&Handler::Member>(h);
+        }
+
+        notify(state, e);
+    }
+
+    void BM_EventLambda(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::event<void (int)> e;
+
+        for (auto& h : handlers)
+        {
+            e.attach([&h](int x) { h.Member(x); });
+        }
+
+        notify(state, e);
+    }
+
+    void BM_SmallEventMember(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::small_event<void (int), 16> e;
+
+        for (auto& h : handlers)
+        {
+            e.attach(&Handler::Member, h);
+        }
+
+        notify(state, e);
+    }
+
+    void BM_NoexceptEventBoundFree(benchmark::State& state)
+    {
+        event::event<void (int) noexcept> e;
+
+        for (std::int64_t i = 0; i < state.range(0); i++)
+        {
+            e.attach<&FreeNoexcept>();
+        }
+
+        notify(state, e);
+    }
+
+    void BM_InstrumentedEventMember(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::event<void (int), event::dispatch_stats<>> e;
+
+        for (auto& h : handlers)
+        {
+            e.attach(&Handler::Member, h);
+        }
+
+        notify(state, e);
+    }
+
+    void BM_FilteredFanout(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::event<void (int, int)> e;
+
+        for (std::size_t key = 0; key < handlers.size(); key++)
+        {
+            e.attach([&h = handlers[key], key](int k, int x)
+            {
+                if (static_cast<std::size_t>(k) == key)
+                    h.Member(x);
+            });
+        }
+
+        for (auto _ : state)
+        {
+            e(0, 1);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void BM_KeyedEvent(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        event::keyed_event<int, void (int)> e;
+
+        for (std::size_t key = 0; key < handlers.size(); key++)
+        {
+            e.attach(static_cast<int>(key), &Handler::Member, handlers[key]);
+        }
+
+        for (auto _ : state)
+        {
+            e(0, 1);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void BM_NotifyBatch(benchmark::State& state)
+    {
+        std::vector<Handler> handlers(state.range(0));
+        std::vector<int> items(64, 1);
+        event::event<void (int)> e;
+
+        for (auto& h : handlers)
+        {
+            e.attach<&Handler::Member>(h);
+        }
+
+        for (auto _ : state)
+        {
+            e.notify_batch(event::span<const int>(items.data(), items.size()));
+            benchmark::ClobberMemory();
+        }
+
+        per_subscriber(state, state.range(0) * static_cast<std::int64_t>(items.size()));
+    }
+
+    void BM_RecordNotification(benchmark::State& state)
+    {
+        std::vector<std::byte> log(64 * 1024);
+        event::event<void (int, int)> e;
+        std::optional<event::recorder<void (int, int)>> rec;
+        event::subscription handle;
+        int x = 0;
+
+        for (auto _ : state)
+        {
+            if (!rec || rec->size() == rec->capacity())
+            {
+                state.PauseTiming();
+                e.detach(handle);
+                rec.emplace(log);
+                handle = rec->attach_to(e);
+                state.ResumeTiming();
+            }
+
+            e(x++, 1);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_ReplayLog(benchmark::State& state)
+    {
+        constexpr int notifications = 4096;
+
+        std::vector<Handler> handlers(state.range(0));
+        std::vector<std::byte> log(sizeof(event::details::log_header) + notifications * 16);
+        event::event<void (int)> e;
+        event::recorder<void (int)> rec(log);
+
+        rec.attach_to(e);
+
+        for (int i = 0; i < notifications; i++)
+        {
+            e(i);
+        }
+
+        e.detach<&event::recorder<void (int)>::record>(rec);
+
+        for (auto& h : handlers)
+        {
+            e.attach<&Handler::Member>(h);
+        }
+
+        event::replayer<void (int)> player(rec.data());
+
+        for (auto _ : state)
+        {
+            player.replay(e);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * notifications);
+    }
+}
+
+BENCHMARK(BM_RawFunctionPointer)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_StdFunction)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_EventFree)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_EventStatic)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_EventMember)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_EventBoundMember)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_EventLambda)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_SmallEventMember)->Arg(1)->Arg(10);
+BENCHMARK(BM_NoexceptEventBoundFree)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_InstrumentedEventMember)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_FilteredFanout)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_KeyedEvent)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_NotifyBatch)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(BM_RecordNotification);
+BENCHMARK(BM_ReplayLog)->Arg(1)->Arg(10);
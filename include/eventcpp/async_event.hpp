@@ -0,0 +1,165 @@
+/**
+ * \brief	Asynchronous C++ event implementation
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __async_event__
+#define __async_event__
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "concurrent_event.hpp"
+#include "executor.hpp"
+
+namespace event
+{
+    template<typename TFunc, typename TExecutor = thread_pool> class async_event;
+
+    /**
+     * \brief An event delivering notifications on an executor
+     *
+     * post queues a copy of the arguments and returns immediately; queued
+     * notifications are delivered one after another on the executor, in the
+     * order they were posted, so every subscriber observes them in order.
+     * Notifying with operator() still delivers synchronously. Subscribers may
+     * be attached and detached from any thread.
+     *
+     * \tparam Args arguments accepted by a callback of a subscriber
+     * \tparam TExecutor type with an execute member function accepting a callable
+     */
+    template<typename ...Args, typename TExecutor>
+    class async_event<void(Args...), TExecutor> : public concurrent_event<void(Args...)>
+    {
+        using _TArgs = std::tuple<std::decay_t<Args>...>;
+
+    public:
+        /**
+         * \brief Create event delivering notifications on the shared thread pool
+         */
+        template<typename _TExecutor = TExecutor,
+            typename = std::enable_if_t<std::is_same<_TExecutor, thread_pool>::value>>
+        async_event() : async_event(thread_pool::shared())
+        {
+        }
+
+        explicit async_event(TExecutor& executor) : _executor(executor)
+        {
+        }
+
+        /**
+         * \brief Wait until queued notifications have been delivered
+         *
+         * An exception thrown by a subscriber and not yet reported by wait is
+         * discarded.
+         */
+        ~async_event()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.wait(lock, [this] { return !_scheduled; });
+        }
+
+        /**
+         * \brief Queue a notification to be delivered on the executor
+         *
+         * A subscriber throwing during delivery stops that notification
+         * only: the exception does not reach the executor, later
+         * notifications are still delivered, and the first such exception is
+         * rethrown by the next call to wait.
+         *
+         * \param args arguments that will be passed to subscribed callbacks
+         */
+        void post(Args... args)
+        {
+            bool schedule;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                _queue.emplace_back(std::forward<Args>(args)...);
+                schedule = !_scheduled;
+                _scheduled = true;
+            }
+
+            if (schedule)
+            {
+                _executor.execute([this] { drain(); });
+            }
+        }
+
+        /**
+         * \brief Wait until queued notifications have been delivered
+         *
+         * Must not be called from a subscriber of this event.
+         *
+         * \throw the first exception thrown by a subscriber during delivery
+         *        since the previous call
+         */
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.wait(lock, [this] { return !_scheduled; });
+
+            if (_error)
+                std::rethrow_exception(std::exchange(_error, nullptr));
+        }
+
+    private:
+        TExecutor& _executor;
+        std::mutex _mutex;
+        std::condition_variable _idle;
+        std::deque<_TArgs> _queue;
+        bool _scheduled = false;
+        std::exception_ptr _error;
+
+        void drain()
+        {
+            std::deque<_TArgs> batch;
+
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    if (_queue.empty())
+                    {
+                        _scheduled = false;
+                        _idle.notify_all();
+
+                        return;
+                    }
+
+                    batch.swap(_queue);
+                }
+
+                for (auto& args : batch)
+                {
+                    try
+                    {
+                        std::apply([this](auto&... values)
+                        {
+                            (*this)(static_cast<Args&&>(values)...);
+                        }, args);
+                    }
+                    catch (...)
+                    {
+                        // kept for wait, so the drain keeps going and the event does not stall
+                        std::lock_guard<std::mutex> lock(_mutex);
+
+                        if (!_error)
+                            _error = std::current_exception();
+                    }
+                }
+
+                batch.clear();
+            }
+        }
+    };
+}
+
+#endif // !__async_event__
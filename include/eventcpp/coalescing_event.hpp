@@ -0,0 +1,164 @@
+/**
+ * \brief	Event collapsing bursts of notifications into one
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __coalescing_event__
+#define __coalescing_event__
+
+#include <chrono>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "event.hpp"
+
+namespace event
+{
+    /**
+     * \brief Merge policy keeping the arguments of the latest notification
+     */
+    struct keep_latest
+    {
+        template<typename TArgs>
+        void operator() (TArgs& pending, TArgs&& incoming) const
+        {
+            pending = std::move(incoming);
+        }
+    };
+
+    template<typename TFunc, typename TMerge = keep_latest, typename TClock = std::chrono::steady_clock>
+    class coalescing_event;
+
+    /**
+     * \brief An event delivering at most one notification per flush or interval
+     *
+     * post records the arguments instead of notifying; arguments posted
+     * before the next delivery are merged into the recorded ones by TMerge,
+     * which by default keeps the latest. flush delivers the recorded
+     * arguments to subscribers attached as to any event.
+     *
+     * With an interval, post delivers right away if the previous delivery
+     * is at least the interval old, and poll delivers recorded arguments once
+     * it is, so subscribers are notified at most once per interval and the
+     * last posted arguments are not lost.
+     *
+     * \tparam Args arguments accepted by a callback of a subscriber
+     * \tparam TMerge callable merging incoming arguments into the recorded
+     *         ones, both as std::tuple of the decayed arguments
+     * \tparam TClock clock measuring the interval
+     */
+    template<typename ...Args, typename TMerge, typename TClock>
+    class coalescing_event<void(Args...), TMerge, TClock> : public event<void(Args...)>
+    {
+        using _TArgs = std::tuple<std::decay_t<Args>...>;
+
+    public:
+        using duration = typename TClock::duration;
+
+        /**
+         * \brief Create event delivering on flush only
+         */
+        explicit coalescing_event(TMerge merge = TMerge()) : _merge(std::move(merge))
+        {
+        }
+
+        /**
+         * \brief Create event delivering at most once per interval
+         */
+        explicit coalescing_event(duration interval, TMerge merge = TMerge())
+            : _merge(std::move(merge)), _interval(interval)
+        {
+        }
+
+        /**
+         * \brief Record a notification, delivering it if the interval allows
+         *
+         * \param args arguments that will be passed to subscribed callbacks
+         * \return whether the notification was delivered right away
+         */
+        bool post(Args... args)
+        {
+            if (_pending)
+            {
+                _merge(*_pending, _TArgs(std::forward<Args>(args)...));
+            }
+            else
+            {
+                _pending.emplace(std::forward<Args>(args)...);
+            }
+
+            return _interval != duration::zero() && poll();
+        }
+
+        /**
+         * \brief Deliver the recorded notification if the interval has elapsed
+         *
+         * \return whether a notification was delivered
+         */
+        bool poll()
+        {
+            if (!_pending)
+                return false;
+
+            auto now = TClock::now();
+
+            if (_delivered && now - *_delivered < _interval)
+                return false;
+
+            _delivered = now;
+            deliver();
+
+            return true;
+        }
+
+        /**
+         * \brief Deliver the recorded notification regardless of the interval
+         *
+         * \return whether a notification was delivered
+         */
+        bool flush()
+        {
+            if (!_pending)
+                return false;
+
+            if (_interval != duration::zero())
+                _delivered = TClock::now();
+
+            deliver();
+
+            return true;
+        }
+
+        /**
+         * \brief Check whether a notification is waiting to be delivered
+         */
+        bool pending() const noexcept
+        {
+            return _pending.has_value();
+        }
+
+    private:
+        TMerge _merge;
+        duration _interval = duration::zero();
+        std::optional<_TArgs> _pending;
+        std::optional<typename TClock::time_point> _delivered;
+
+        /**
+         * \brief Notify subscribers, taking the recorded arguments first so they may post again
+         */
+        void deliver()
+        {
+            auto args = std::move(*_pending);
+            _pending.reset();
+
+            std::apply([this](auto&... values)
+            {
+                (*this)(static_cast<Args&&>(values)...);
+            }, args);
+        }
+    };
+}
+
+#endif // !__coalescing_event__
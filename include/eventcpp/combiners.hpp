@@ -0,0 +1,221 @@
+/**
+ * \brief	Combiners aggregating results of event subscribers
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __event_combiners__
+#define __event_combiners__
+
+#include <optional>
+#include <utility>
+
+namespace event
+{
+    /**
+     * \brief Combiners passed to event::invoke
+     *
+     * A combiner receives the result of every notified subscriber through
+     * bool operator() (T), returning false to stop the notification, and
+     * provides the combined value through result().
+     */
+    namespace combiners
+    {
+        /**
+         * \brief Result of the first subscriber, the remaining ones are not called
+         */
+        template<typename T>
+        class first
+        {
+        public:
+            bool operator() (T value)
+            {
+                _value.emplace(std::move(value));
+
+                return false;
+            }
+
+            std::optional<T> result()
+            {
+                return std::move(_value);
+            }
+
+        private:
+            std::optional<T> _value;
+        };
+
+        /**
+         * \brief Result of the last subscriber
+         */
+        template<typename T>
+        class last
+        {
+        public:
+            bool operator() (T value)
+            {
+                _value.emplace(std::move(value));
+
+                return true;
+            }
+
+            std::optional<T> result()
+            {
+                return std::move(_value);
+            }
+
+        private:
+            std::optional<T> _value;
+        };
+
+        /**
+         * \brief Sum of results of all subscribers
+         */
+        template<typename T>
+        class sum
+        {
+        public:
+            explicit sum(T init = T()) : _value(std::move(init))
+            {
+            }
+
+            bool operator() (T value)
+            {
+                _value += std::move(value);
+
+                return true;
+            }
+
+            T result()
+            {
+                return std::move(_value);
+            }
+
+        private:
+            T _value;
+        };
+
+        /**
+         * \brief Smallest result of all subscribers
+         */
+        template<typename T>
+        class minimum
+        {
+        public:
+            bool operator() (T value)
+            {
+                if (!_value || value < *_value)
+                    _value.emplace(std::move(value));
+
+                return true;
+            }
+
+            std::optional<T> result()
+            {
+                return std::move(_value);
+            }
+
+        private:
+            std::optional<T> _value;
+        };
+
+        /**
+         * \brief Largest result of all subscribers
+         */
+        template<typename T>
+        class maximum
+        {
+        public:
+            bool operator() (T value)
+            {
+                if (!_value || *_value < value)
+                    _value.emplace(std::move(value));
+
+                return true;
+            }
+
+            std::optional<T> result()
+            {
+                return std::move(_value);
+            }
+
+        private:
+            std::optional<T> _value;
+        };
+
+        /**
+         * \brief True if any subscriber returns true, stops at the first one that does
+         */
+        template<typename T = bool>
+        class any_of
+        {
+        public:
+            bool operator() (const T& value)
+            {
+                _value = static_cast<bool>(value);
+
+                return !_value;
+            }
+
+            bool result() const noexcept
+            {
+                return _value;
+            }
+
+        private:
+            bool _value = false;
+        };
+
+        /**
+         * \brief True if all subscribers return true, stops at the first one that does not
+         */
+        template<typename T = bool>
+        class all_of
+        {
+        public:
+            bool operator() (const T& value)
+            {
+                _value = static_cast<bool>(value);
+
+                return _value;
+            }
+
+            bool result() const noexcept
+            {
+                return _value;
+            }
+
+        private:
+            bool _value = true;
+        };
+
+        /**
+         * \brief Write results of all subscribers to an output iterator
+         */
+        template<typename TOutputIt>
+        class collect
+        {
+        public:
+            explicit collect(TOutputIt out) : _out(std::move(out))
+            {
+            }
+
+            template<typename T>
+            bool operator() (T&& value)
+            {
+                *_out = std::forward<T>(value);
+                ++_out;
+
+                return true;
+            }
+
+            TOutputIt result()
+            {
+                return std::move(_out);
+            }
+
+        private:
+            TOutputIt _out;
+        };
+    }
+}
+
+#endif // !__event_combiners__
@@ -0,0 +1,476 @@
+/**
+ * \brief	Thread-safe C++ event implementation
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __concurrent_event__
+#define __concurrent_event__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "event.hpp"
+
+namespace event
+{
+    namespace details
+    {
+        /**
+         * \brief Epoch-based reclamation domain protecting published snapshots
+         *
+         * Readers register in one of two epochs on a counter stripe chosen per
+         * thread, so concurrent readers rarely share a cache line. Writers
+         * advance the epoch once every reader of the previous epoch has left;
+         * an object retired in epoch E can be freed once the epoch reaches
+         * E + 2, as no reader that could have seen it remains.
+         */
+        class epoch_domain
+        {
+            static constexpr std::size_t _stripes = 16;
+            static constexpr std::size_t _cache_line = 64;
+
+            struct alignas(_cache_line) counter
+            {
+                std::atomic<std::size_t> readers{ 0 };
+            };
+
+        public:
+            class guard
+            {
+            public:
+                explicit guard(epoch_domain& domain) noexcept : _counter(domain.enter())
+                {
+                }
+
+                guard(const guard&) = delete;
+                guard& operator= (const guard&) = delete;
+
+                ~guard()
+                {
+                    _counter->readers.fetch_sub(1, std::memory_order_release);
+                }
+
+            private:
+                counter* _counter;
+            };
+
+            std::uint64_t epoch() const noexcept
+            {
+                return _epoch.load();
+            }
+
+            /**
+             * \brief Advance the epoch if no reader of the previous one is left
+             *
+             * Safe to call from several threads: the epoch only moves from the
+             * value whose readers were counted, so a check is never credited
+             * to another epoch.
+             */
+            bool try_advance() noexcept
+            {
+                auto epoch = _epoch.load();
+
+                if (readers((epoch + 1) & 1) != 0)
+                    return false;
+
+                return _epoch.compare_exchange_strong(epoch, epoch + 1);
+            }
+
+            /**
+             * \brief Wait until every reader that entered before the call has left
+             */
+            void synchronize() noexcept
+            {
+                auto target = _epoch.load() + 2;
+
+                while (_epoch.load() < target)
+                {
+                    if (!try_advance())
+                        std::this_thread::yield();
+                }
+            }
+
+        private:
+            std::atomic<std::uint64_t> _epoch{ 0 };
+            counter _counters[2][_stripes];
+
+            counter* enter() noexcept
+            {
+                auto stripe = thread_stripe();
+
+                for (;;)
+                {
+                    auto epoch = _epoch.load();
+                    auto counter = &_counters[epoch & 1][stripe];
+
+                    counter->readers.fetch_add(1);
+
+                    if (_epoch.load() == epoch)
+                        return counter;
+
+                    counter->readers.fetch_sub(1, std::memory_order_release);
+                }
+            }
+
+            std::size_t readers(std::size_t parity) const noexcept
+            {
+                std::size_t count = 0;
+
+                for (const auto& counter : _counters[parity])
+                {
+                    count += counter.readers.load();
+                }
+
+                return count;
+            }
+
+            static std::size_t thread_stripe() noexcept
+            {
+                static std::atomic<std::size_t> next{ 0 };
+                static thread_local std::size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % _stripes;
+
+                return stripe;
+            }
+        };
+    }
+
+    template<typename TFunc> class concurrent_event;
+
+    /**
+     * \brief A thread-safe container class for subscribers to be notified
+     *
+     * Subscribers are kept in an immutable snapshot. Notifying reads the
+     * current snapshot without locking, while attach and detach copy it,
+     * publish the copy and retire the old one, which is freed once no
+     * notification can be using it. Attaching and detaching are serialized
+     * by a mutex and may be called from subscribers.
+     *
+     * A notification that started before detach returned may still call the
+     * detached subscriber; use synchronize to wait for such notifications.
+     * Subscribers of destroyed tracked objects are skipped and dropped by the
+     * next attach or detach.
+     *
+     * \tparam TRet type returned by a callback of a subscriber
+     * \tparam Args arguments accepted by a callback of a subscriber
+     */
+    template<typename TRet, typename ...Args>
+    class concurrent_event<TRet(Args...)> : public details::subscribable<concurrent_event<TRet(Args...)>, TRet(Args...)>
+    {
+        friend class details::subscribable<concurrent_event<TRet(Args...)>, TRet(Args...)>;
+
+        using _TDelegate = details::delegate<TRet(Args...)>;
+
+        struct _TSlot
+        {
+            _TDelegate invokable;
+            std::uint64_t key;
+            int priority;
+            bool owning;
+            details::guard_base* guard;
+
+            bool notifiable() const noexcept
+            {
+                return guard == nullptr || !guard->expired();
+            }
+        };
+
+        /**
+         * \brief Published subscriber list, holding a reference to every closure it calls
+         */
+        struct snapshot
+        {
+            std::vector<_TSlot> slots;
+
+            snapshot() = default;
+
+            snapshot(const snapshot& other) : slots(other.slots)
+            {
+                for (const auto& slot : slots)
+                {
+                    if (slot.owning)
+                        slot.invokable.retain();
+
+                    if (slot.guard != nullptr)
+                        slot.guard->retain();
+                }
+            }
+
+            snapshot& operator= (const snapshot&) = delete;
+
+            ~snapshot()
+            {
+                for (const auto& slot : slots)
+                {
+                    release(slot);
+                }
+            }
+
+            static void release(const _TSlot& slot) noexcept
+            {
+                if (slot.owning)
+                    slot.invokable.release();
+
+                if (slot.guard != nullptr)
+                    slot.guard->release();
+            }
+        };
+
+        struct retired
+        {
+            const snapshot* ptr;
+            std::uint64_t epoch;
+        };
+
+    public:
+        concurrent_event() = default;
+
+        concurrent_event(const concurrent_event&) = delete;
+        concurrent_event& operator= (const concurrent_event&) = delete;
+
+        /**
+         * \brief Destroy event, no notification may be running
+         */
+        ~concurrent_event()
+        {
+            delete _current.load();
+
+            for (const auto& r : _retired)
+            {
+                delete r.ptr;
+            }
+        }
+
+        /**
+         * \brief The function call operator for notifying subscribers
+         *
+         * Safe to call concurrently from any number of threads and concurrently
+         * with attach and detach.
+         *
+         * \param args arguments that will be passed to subscribed callbacks
+         * \return TRet type returned by a callback of a subscriber
+         */
+        template<typename _TRet = TRet>
+        std::enable_if_t<!std::is_same<_TRet, void>::value, _TRet>
+            operator() (Args... args) const
+        {
+            details::epoch_domain::guard guard(_domain);
+
+            auto snap = _current.load();
+
+            if (snap == nullptr || snap->slots.empty())
+                return details::empty_result<_TRet>();
+
+            auto count = snap->slots.size();
+
+            for (std::size_t i = 0; i + 1 < count; i++)
+            {
+                if (snap->slots[i].notifiable())
+                    snap->slots[i].invokable(details::forward_copy<Args>(args)...);
+            }
+
+            if (!snap->slots[count - 1].notifiable())
+                return details::empty_result<_TRet>();
+
+            return snap->slots[count - 1].invokable(std::forward<Args>(args)...);
+        }
+
+        template<typename _TRet = TRet>
+        std::enable_if_t<std::is_same<_TRet, void>::value, _TRet>
+            operator() (Args... args) const
+        {
+            details::epoch_domain::guard guard(_domain);
+
+            auto snap = _current.load();
+
+            if (snap == nullptr || snap->slots.empty())
+                return;
+
+            auto count = snap->slots.size();
+
+            for (std::size_t i = 0; i + 1 < count; i++)
+            {
+                if (snap->slots[i].notifiable())
+                    snap->slots[i].invokable(details::forward_copy<Args>(args)...);
+            }
+
+            if (snap->slots[count - 1].notifiable())
+                snap->slots[count - 1].invokable(std::forward<Args>(args)...);
+        }
+
+        /**
+         * \brief Number of attached subscribers
+         */
+        std::size_t size() const noexcept
+        {
+            details::epoch_domain::guard guard(_domain);
+            auto snap = _current.load();
+
+            return snap != nullptr ? snap->slots.size() : 0;
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /**
+         * \brief Wait until notifications that started before the call have finished
+         *
+         * Must not be called from a subscriber of this event.
+         */
+        void synchronize()
+        {
+            _domain.synchronize();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            reclaim();
+        }
+
+    private:
+        mutable details::epoch_domain _domain;
+        std::atomic<const snapshot*> _current{ nullptr };
+        std::mutex _mutex;
+        std::vector<retired> _retired;
+        std::uint64_t _attached = 0;
+
+        std::pmr::memory_resource* resource() const noexcept
+        {
+            return std::pmr::get_default_resource();
+        }
+
+        subscription insert(const _TDelegate& invokable, int priority, bool owning = false,
+            details::guard_base* guard = nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto snap = copy();
+            auto key = ++_attached;
+            auto position = std::upper_bound(snap->slots.begin(), snap->slots.end(), priority,
+                [](int priority, const _TSlot& slot)
+            {
+                return priority > slot.priority;
+            });
+
+            snap->slots.insert(position, _TSlot{ invokable, key, priority, owning, guard });
+
+            if (guard != nullptr)
+                guard->retain();
+
+            publish(snap);
+
+            return details::subscription_access::make(static_cast<std::uint32_t>(key),
+                static_cast<std::uint32_t>(key >> 32) + 1);
+        }
+
+        bool remove(subscription handle)
+        {
+            if (!handle.valid())
+                return false;
+
+            auto key = static_cast<std::uint64_t>(details::subscription_access::generation(handle) - 1) << 32
+                | details::subscription_access::id(handle);
+
+            return erase_if([key](const _TSlot& slot)
+            {
+                return slot.key == key;
+            });
+        }
+
+        void remove(const _TDelegate& invokable)
+        {
+            erase_if([&invokable](const _TSlot& slot)
+            {
+                return slot.invokable == invokable;
+            });
+        }
+
+        template<typename TPredicate>
+        bool erase_if(TPredicate predicate)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto current = _current.load();
+
+            if (current == nullptr)
+                return false;
+
+            for (std::size_t i = 0; i < current->slots.size(); i++)
+            {
+                if (predicate(current->slots[i]))
+                {
+                    auto snap = copy();
+
+                    snapshot::release(snap->slots[i]);
+                    snap->slots.erase(snap->slots.begin() + i);
+                    publish(snap);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        snapshot* copy() const
+        {
+            auto current = _current.load();
+
+            return current != nullptr ? new snapshot(*current) : new snapshot();
+        }
+
+        /**
+         * \brief Publish a snapshot, dropping the subscribers of destroyed objects
+         */
+        void publish(snapshot* snap)
+        {
+            auto expired = std::remove_if(snap->slots.begin(), snap->slots.end(), [](const _TSlot& slot)
+            {
+                if (slot.notifiable())
+                    return false;
+
+                snapshot::release(slot);
+
+                return true;
+            });
+
+            snap->slots.erase(expired, snap->slots.end());
+
+            auto old = _current.exchange(snap);
+
+            if (old != nullptr)
+            {
+                _retired.push_back(retired{ old, _domain.epoch() });
+            }
+
+            reclaim();
+        }
+
+        void reclaim()
+        {
+            if (_retired.empty())
+                return;
+
+            while (_domain.epoch() < _retired.back().epoch + 2 && _domain.try_advance())
+            {
+            }
+
+            auto epoch = _domain.epoch();
+            auto it = _retired.begin();
+
+            while (it != _retired.end() && it->epoch + 2 <= epoch)
+            {
+                delete it->ptr;
+                it++;
+            }
+
+            _retired.erase(_retired.begin(), it);
+        }
+    };
+}
+
+#endif // !__concurrent_event__
@@ -6,265 +6,3809 @@
 #ifndef __event__
 #define __event__
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
-#include <list>
+#include <memory_resource>
+#include <new>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <tuple>
 #include <type_traits>
-#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <deque>
+#define EVENTCPP_COROUTINES 1
+#endif
 
 namespace event
 {
     namespace details
     {
-        template<typename TRet, typename ...Args> class invokable_abstract;
+        struct subscription_access;
+        struct tracked_access;
+    }
 
-        template<typename TRet, typename ...Args>
-        inline bool operator!= (const invokable_abstract<TRet, Args...>& lhs,
-            const invokable_abstract<TRet, Args...>& rhs)
+    template<typename TFunc> class frozen_event;
+
+    /**
+     * \brief A non-owning view over a contiguous sequence of objects
+     */
+    template<typename T>
+    class span
+    {
+    public:
+        using element_type = T;
+        using iterator = T*;
+
+        constexpr span() noexcept : _data(nullptr), _size(0)
         {
-            return lhs.get_func_ptr() != rhs.get_func_ptr() && lhs.get_obj_ptr() != rhs.get_obj_ptr();
         }
 
-        template<typename TRet, typename ...Args>
-        class invokable_abstract
+        constexpr span(T* data, std::size_t size) noexcept : _data(data), _size(size)
         {
-        public:
-            virtual TRet operator() (Args&&...) = 0;
-            virtual std::string get_func_ptr() const = 0;
-            virtual uintptr_t get_obj_ptr() const = 0;
-        };
+        }
 
-        template<typename TRet, typename ...Args>
-        class invokable_func : public invokable_abstract<TRet, Args...>
+        template<std::size_t N>
+        constexpr span(T (&data)[N]) noexcept : _data(data), _size(N)
         {
-            using _TFuncPtr = typename std::add_pointer<TRet(Args...)>::type;
+        }
 
-        public:
-            invokable_func(_TFuncPtr func) : _func(func)
+        template<typename TContainer, typename = std::enable_if_t<
+            !std::is_same<std::decay_t<TContainer>, span>::value
+            && std::is_convertible<decltype(std::declval<TContainer&>().data()), T*>::value>>
+        constexpr span(TContainer&& container) noexcept : _data(container.data()), _size(container.size())
+        {
+        }
+
+        constexpr T* data() const noexcept { return _data; }
+        constexpr std::size_t size() const noexcept { return _size; }
+        constexpr bool empty() const noexcept { return _size == 0; }
+
+        constexpr T* begin() const noexcept { return _data; }
+        constexpr T* end() const noexcept { return _data + _size; }
+
+        constexpr T& operator[] (std::size_t idx) const noexcept { return _data[idx]; }
+
+    private:
+        T* _data;
+        std::size_t _size;
+    };
+
+    /**
+     * \brief Value returned by a subscriber to control propagation of a notification
+     *
+     * Notifying an event returning dispatch_result stops at the first
+     * subscriber returning stop.
+     */
+    enum class dispatch_result
+    {
+        proceed,
+        stop
+    };
+
+    /**
+     * \brief Dispatch policy stopping at the first subscriber returning false
+     */
+    struct until_false
+    {
+        template<typename T>
+        static bool proceed(const T& result)
+        {
+            return static_cast<bool>(result);
+        }
+    };
+
+    /**
+     * \brief Dispatch policy stopping at the first subscriber returning true
+     */
+    struct until_true
+    {
+        template<typename T>
+        static bool proceed(const T& result)
+        {
+            return !static_cast<bool>(result);
+        }
+    };
+
+    /**
+     * \brief Dispatch policy stopping at the first subscriber returning dispatch_result::stop
+     */
+    struct until_stop
+    {
+        static bool proceed(dispatch_result result)
+        {
+            return result != dispatch_result::stop;
+        }
+    };
+
+    /**
+     * \brief Instrumentation policy recording nothing, compiled out of the dispatch loop
+     *
+     * An enabled policy declares enabled as true, a clock with a static now()
+     * and the hooks below, which must not throw. The event calls
+     * on_dispatch(std::size_t subscribers) once per notification and
+     * on_call(subscription subscriber, clock::duration elapsed) after every
+     * subscriber it calls. A const event may be notified from several
+     * threads at once, and so may the hooks of its policy be called; a
+     * policy that is not safe to call concurrently limits its event to one
+     * notifying thread. See dispatch_stats in instrumentation.hpp.
+     */
+    struct no_instrumentation
+    {
+        static constexpr bool enabled = false;
+    };
+
+    /**
+     * \brief A handle identifying a single subscriber of an event
+     *
+     * Returned by attach and accepted by detach, which then runs in constant
+     * time. A handle is only meaningful for the event that issued it; once the
+     * subscriber is detached the handle is stale and detaching it again does
+     * nothing.
+     */
+    class subscription
+    {
+    public:
+        subscription() noexcept = default;
+
+        /**
+         * \brief Check whether handle was issued by an event
+         */
+        bool valid() const noexcept
+        {
+            return _generation != 0;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return valid();
+        }
+
+        friend bool operator== (const subscription& lhs, const subscription& rhs) noexcept
+        {
+            return lhs._id == rhs._id && lhs._generation == rhs._generation;
+        }
+
+        friend bool operator!= (const subscription& lhs, const subscription& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend struct details::subscription_access;
+
+        std::uint32_t _id = 0;
+        std::uint32_t _generation = 0;
+
+        subscription(std::uint32_t id, std::uint32_t generation) noexcept : _id(id), _generation(generation)
+        {
+        }
+    };
+
+    /**
+     * \brief RAII owner of a subscription detaching it on destruction
+     *
+     * The owned handle refers to the event by address, so the event must
+     * outlive the scoped_subscription and must not be moved in the meantime.
+     */
+    class scoped_subscription
+    {
+    public:
+        scoped_subscription() noexcept = default;
+
+        template<typename TEvent>
+        scoped_subscription(TEvent& e, subscription handle) noexcept
+            : _event(std::addressof(e)), _detach(&detach_from<TEvent>), _handle(handle)
+        {
+        }
+
+        scoped_subscription(const scoped_subscription&) = delete;
+        scoped_subscription& operator= (const scoped_subscription&) = delete;
+
+        scoped_subscription(scoped_subscription&& other) noexcept
+            : _event(other._event), _detach(other._detach), _handle(other.release())
+        {
+        }
+
+        scoped_subscription& operator= (scoped_subscription&& other) noexcept
+        {
+            if (this != &other)
             {
+                reset();
+                _event = other._event;
+                _detach = other._detach;
+                _handle = other.release();
             }
 
-            TRet operator() (Args&&... args) override
-            {
-                if (_func == nullptr)
-                    throw std::bad_function_call();
+            return *this;
+        }
+
+        ~scoped_subscription()
+        {
+            reset();
+        }
 
-                return std::invoke(_func, std::forward<Args>(args)...);
+        /**
+         * \brief Dettach owned subscriber, if any
+         */
+        void reset()
+        {
+            if (_event != nullptr)
+            {
+                _detach(_event, _handle);
             }
 
-            std::string get_func_ptr() const override
+            _event = nullptr;
+            _handle = subscription();
+        }
+
+        /**
+         * \brief Give up ownership without detaching the subscriber
+         */
+        subscription release() noexcept
+        {
+            auto handle = _handle;
+
+            _event = nullptr;
+            _handle = subscription();
+
+            return handle;
+        }
+
+        subscription get() const noexcept
+        {
+            return _handle;
+        }
+
+    private:
+        void* _event = nullptr;
+        void (*_detach)(void*, subscription) = nullptr;
+        subscription _handle;
+
+        template<typename TEvent>
+        static void detach_from(void* e, subscription handle)
+        {
+            static_cast<TEvent*>(e)->detach(handle);
+        }
+    };
+
+    namespace details
+    {
+        /**
+         * \brief Reference counted check whether the object of a subscriber still exists
+         */
+        class guard_base
+        {
+        public:
+            /**
+             * \brief Deleter dropping the reference owned by a std::unique_ptr
+             */
+            struct releaser
             {
-                auto tmp = static_cast<const char*>(static_cast<const void*>(&_func));
-                std::string tmpstr(tmp);
+                void operator() (guard_base* g) const noexcept
+                {
+                    g->release();
+                }
+            };
+
+            guard_base(const guard_base&) = delete;
+            guard_base& operator= (const guard_base&) = delete;
+
+            virtual bool expired() const noexcept = 0;
 
-                return tmpstr;
+            void retain() noexcept
+            {
+                _refs.fetch_add(1, std::memory_order_relaxed);
             }
 
-            uintptr_t get_obj_ptr() const override
+            void release() noexcept
             {
-                return reinterpret_cast<uintptr_t>(nullptr);
+                if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete this;
             }
 
+        protected:
+            guard_base() noexcept = default;
+            virtual ~guard_base() = default;
+
         private:
-            _TFuncPtr _func;
+            std::atomic<std::size_t> _refs{ 1 };
         };
 
-        template<typename TRet, typename TClass, typename ...Args>
-        class invokable_member : public invokable_abstract<TRet, Args...>
+        /**
+         * \brief Lifetime flag of a tracked object, cleared when it is destroyed
+         */
+        class lifetime final : public guard_base
         {
-            using _TFuncPtr = TRet(TClass::*) (Args...);
-            using _TClassRef = typename std::add_lvalue_reference<TClass>::type;
-
         public:
-            invokable_member(_TFuncPtr func, _TClassRef obj) : _func(func), _obj(obj)
+            bool expired() const noexcept override
             {
+                return !_alive.load(std::memory_order_acquire);
             }
 
-            TRet operator() (Args&&... args) override
+            void expire() noexcept
             {
-                if (_func == nullptr || &_obj == nullptr)
-                    throw std::bad_function_call();
-
-                return std::invoke(_func, _obj, std::forward<Args>(args)...);
+                _alive.store(false, std::memory_order_release);
             }
 
-            std::string get_func_ptr() const override
-            {
-                auto tmp = static_cast<const char*>(static_cast<const void*>(&_func));
-                std::string tmpstr(tmp);
+        private:
+            std::atomic<bool> _alive{ true };
+        };
 
-                return tmpstr;
+        /**
+         * \brief Guard of an object owned by a std::shared_ptr
+         *
+         * Checking expiry reads the use count only; no shared_ptr is locked.
+         */
+        template<typename TClass>
+        class weak_guard final : public guard_base
+        {
+        public:
+            explicit weak_guard(std::weak_ptr<TClass> target) noexcept : _target(std::move(target))
+            {
             }
 
-            uintptr_t get_obj_ptr() const override
+            bool expired() const noexcept override
             {
-                return reinterpret_cast<uintptr_t>(&_obj);
+                return _target.expired();
             }
 
         private:
-            _TFuncPtr _func;
-            _TClassRef _obj;
+            std::weak_ptr<TClass> _target;
         };
     }
 
-    template<typename TFunc> class event;
-
     /**
-     * \brief A container class for subscribers to be notified
+     * \brief Base class of subscribers that detach themselves when destroyed
      *
-     * \tparam TRet type returned by a callback of a subscriber
-     * \tparam Args arguments accepted by a callback of a subscriber
+     * Member functions of a class deriving from tracked are attached together
+     * with its lifetime flag. Destroying the object clears the flag, so events
+     * skip its subscribers and drop them when they next reach them, without
+     * locking a weak pointer on every notification. The object must not be
+     * destroyed while one of its member functions is being notified from
+     * another thread.
      */
-    template<typename TRet, typename ...Args>
-    class event<TRet(Args...)>
+    class tracked
     {
-        using _TFunc = TRet(Args...);
-        using _TFuncPtr = typename std::add_pointer<_TFunc>::type;
-        using _TInvokable = details::invokable_abstract<TRet, Args...>;
-
     public:
+        tracked() : _lifetime(new details::lifetime())
+        {
+        }
+
         /**
-         * \brief The function call operator for notifying subscribers
-         *
-         * \param args arguments that will be passed to subscribed callbacks
-         * \return TRet type returned by a callback of a subscriber
+         * \brief Copies are tracked on their own, subscriptions are not copied
          */
-        template<typename _TRet = TRet>
-        std::enable_if_t<!std::is_same<_TRet, void>::value, _TRet>
-            operator() (Args&&... args)
+        tracked(const tracked&) : tracked()
         {
-            _TRet ret;
+        }
 
-            for (auto invokable : _invokables)
-            {
-                ret = std::invoke(*invokable, std::forward<Args>(args)...);
-            }
+        tracked& operator= (const tracked&) noexcept
+        {
+            return *this;
+        }
 
-            return ret;
+        ~tracked()
+        {
+            _lifetime->expire();
+            _lifetime->release();
         }
 
-        template<typename _TRet = TRet>
-        std::enable_if_t<std::is_same<_TRet, void>::value, _TRet>
-            operator() (Args&&... args)
+    private:
+        friend struct details::tracked_access;
+
+        details::lifetime* _lifetime;
+    };
+
+    namespace details
+    {
+        struct tracked_access
         {
-            for (auto invokable : _invokables)
+            /**
+             * \brief Lifetime flag of an object, nullptr if it is not tracked
+             */
+            template<typename TClass>
+            static guard_base* guard(TClass& obj) noexcept
             {
-                std::invoke(*invokable, std::forward<Args>(args)...);
+                if constexpr (std::is_base_of<tracked, std::remove_cv_t<TClass>>::value)
+                    return static_cast<const tracked&>(obj)._lifetime;
+                else
+                    return nullptr;
+            }
+        };
+
+        struct subscription_access
+        {
+            static subscription make(std::uint32_t id, std::uint32_t generation) noexcept
+            {
+                return subscription(id, generation);
+            }
+
+            static std::uint32_t id(const subscription& handle) noexcept
+            {
+                return handle._id;
             }
-        }
+
+            static std::uint32_t generation(const subscription& handle) noexcept
+            {
+                return handle._generation;
+            }
+        };
+
+        template<typename T>
+        using forward_copy_t = std::conditional_t<std::is_reference<T>::value, T&&, T>;
 
         /**
-         * \brief Attach function callback
+         * \brief Pass an argument to a subscriber that is not the last one
+         *
+         * Arguments taken by value are copied, so a subscriber receives an
+         * object of its own; references are passed through, which is why
+         * subscribers must take rvalue reference arguments by reference. A
+         * move-only argument could only be moved into one subscriber, so the
+         * event has to take it by reference instead.
          */
-        void attach(_TFuncPtr func)
+        template<typename T>
+        forward_copy_t<T> forward_copy(std::remove_reference_t<T>& arg)
         {
-            std::shared_ptr<details::invokable_func<TRet, Args...>> ptr(new details::invokable_func<TRet, Args... >(func));
-            _invokables.push_back(ptr);
+            static_assert(std::is_reference<T>::value || std::is_copy_constructible<T>::value,
+                "arguments taken by value must be copy constructible, take move-only types by reference");
+
+            return static_cast<forward_copy_t<T>>(arg);
         }
 
         /**
-         * \brief Attach member function callback
+         * \brief Result of notifying an event without subscribers
          */
-        template<typename TClass>
-        void attach(TRet(TClass::* func) (Args...), TClass& obj)
+        template<typename TRet>
+        TRet empty_result()
         {
-            std::shared_ptr<details::invokable_member<TRet, TClass, Args...>> ptr(new details::invokable_member<TRet, TClass, Args...>(func, obj));
-            _invokables.push_back(ptr);
+            if constexpr (std::is_default_constructible<TRet>::value)
+                return TRet();
+            else
+                throw std::bad_function_call();
         }
 
         /**
-         * \brief Attach member function callback
+         * \brief Reference counted heap storage of a callable too large for a delegate
+         *
+         * The storage is allocated from a memory resource, shared by every
+         * container holding the delegate and destroyed with the last reference.
          */
-        template<typename TClass>
-        void attach(TRet(TClass::* func) (Args...), TClass* obj)
+        class closure_base
         {
-            attach(func, *obj);
-        }
+        public:
+            /**
+             * \brief Deleter dropping the reference owned by a std::unique_ptr
+             */
+            struct releaser
+            {
+                void operator() (closure_base* c) const noexcept
+                {
+                    c->release();
+                }
+            };
+
+            closure_base(const closure_base&) = delete;
+            closure_base& operator= (const closure_base&) = delete;
+
+            void retain() noexcept
+            {
+                _refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release() noexcept
+            {
+                if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    destroy();
+            }
+
+        protected:
+            explicit closure_base(std::pmr::memory_resource* resource) noexcept : _resource(resource)
+            {
+            }
+
+            ~closure_base() = default;
+
+            std::pmr::memory_resource* resource() const noexcept
+            {
+                return _resource;
+            }
+
+        private:
+            std::atomic<std::size_t> _refs{ 1 };
+            std::pmr::memory_resource* _resource;
+
+            virtual void destroy() noexcept = 0;
+        };
+
+        template<typename TCallable>
+        class closure final : public closure_base
+        {
+        public:
+            /**
+             * \brief Allocate a closure from a memory resource holding one reference
+             */
+            template<typename T>
+            static std::unique_ptr<closure, releaser> create(std::pmr::memory_resource* resource, T&& func)
+            {
+                void* ptr = resource->allocate(sizeof(closure), alignof(closure));
+
+                try
+                {
+                    return std::unique_ptr<closure, releaser>(new (ptr) closure(resource, std::forward<T>(func)));
+                }
+                catch (...)
+                {
+                    resource->deallocate(ptr, sizeof(closure), alignof(closure));
+                    throw;
+                }
+            }
+
+            TCallable func;
+
+        private:
+            template<typename T>
+            closure(std::pmr::memory_resource* resource, T&& func) : closure_base(resource), func(std::forward<T>(func))
+            {
+            }
+
+            void destroy() noexcept override
+            {
+                auto resource = this->resource();
+
+                this->~closure();
+                resource->deallocate(this, sizeof(closure), alignof(closure));
+            }
+        };
 
         /**
-         * \brief Attach member function callback
+         * \brief Whether a callable can be called with Args, without throwing if TNoexcept
          */
-        template<typename TBase, typename TClass>
-        void attach(TRet(TBase::* func) (Args...), TClass& obj)
-        {
-            std::shared_ptr<details::invokable_member<TRet, TClass, Args...>> ptr(new details::invokable_member<TRet, TClass, Args...>(func, obj));
-            _invokables.push_back(ptr);
-        }
+        template<bool TNoexcept, typename TRet, typename TCallable, typename ...Args>
+        constexpr bool is_invocable_v = TNoexcept
+            ? std::is_nothrow_invocable_r<TRet, TCallable, Args...>::value
+            : std::is_invocable_r<TRet, TCallable, Args...>::value;
 
         /**
-         * \brief Attach member function callback
+         * \brief Whether an object can be attached as a generic callable
+         *
+         * Function pointers converting to the event signature are attached as
+         * functions instead, so they can be detached by value.
          */
-        template<typename TBase, typename TClass>
-        void attach(TRet(TBase::* func) (Args...), TClass* obj)
-        {
-            attach(func, *obj);
-        }
+        template<bool TNoexcept, typename TCallable, typename TRet, typename ...Args>
+        constexpr bool is_callable_v = is_invocable_v<TNoexcept, TRet, std::decay_t<TCallable>&, Args...>
+            && !(std::is_function<std::remove_pointer_t<std::decay_t<TCallable>>>::value
+                && std::is_convertible<std::decay_t<TCallable>, TRet(*)(Args...) noexcept(TNoexcept)>::value);
 
         /**
-         * \brief Dettach function callback
+         * \brief Whether a member function can be called on TClass with Args
          */
-        void detach(_TFuncPtr func)
+        template<bool TNoexcept, typename TMember, typename TClass, typename TRet, typename ...Args>
+        constexpr bool is_member_callable_v = std::is_member_function_pointer<TMember>::value && std::is_class<TClass>::value
+            && is_invocable_v<TNoexcept, TRet, TMember, TClass&, Args...>;
+
+        template<typename ...TParams>
+        struct parameter_list
         {
-            details::invokable_func<TRet, Args...> invokable(func);
-            remove(invokable);
-        }
+            using type = std::tuple<TParams...>;
+        };
 
         /**
-         * \brief Dettach member function callback
+         * \brief Parameter types of a function, a member function or a function object
+         *
+         * void when they cannot be told, as for generic lambdas and
+         * overloaded call operators.
          */
-        template<typename TClass>
-        void detach(_TFunc TClass::* func, TClass& obj)
+        template<typename TFunc, typename = void>
+        struct parameters_of
+        {
+            using type = void;
+        };
+
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...), void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) const, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) &, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) const &, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) &&, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) const &&, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) noexcept, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) const noexcept, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) & noexcept, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) const & noexcept, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) && noexcept, void> : parameter_list<TParams...> {};
+        template<typename TRet, typename ...TParams>
+        struct parameters_of<TRet(TParams...) const && noexcept, void> : parameter_list<TParams...> {};
+
+        template<typename TFunc>
+        struct parameters_of<TFunc*, std::enable_if_t<std::is_function<TFunc>::value>> : parameters_of<TFunc> {};
+
+        template<typename TFunc, typename TClass>
+        struct parameters_of<TFunc TClass::*, std::enable_if_t<std::is_function<TFunc>::value>> : parameters_of<TFunc> {};
+
+        template<typename TCallable>
+        struct parameters_of<TCallable, std::enable_if_t<std::is_class<TCallable>::value,
+            std::void_t<decltype(&TCallable::operator())>>> : parameters_of<decltype(&TCallable::operator())> {};
+
+        template<typename ...TParams, typename ...Args>
+        constexpr bool takes_rvalue_by_value(std::tuple<TParams...>*, std::tuple<Args...>*) noexcept
         {
-            details::invokable_member<TRet, TClass, Args...> invokable(func, obj);
-            remove(invokable);
+            if constexpr (sizeof...(TParams) != sizeof...(Args))
+                return false;
+            else
+                return (... || (std::is_rvalue_reference<Args>::value && !std::is_reference<TParams>::value));
         }
 
-        /**
-         * \brief Dettach member function callback
-         */
-        template<typename TClass>
-        void detach(_TFunc TClass::* func, TClass* obj)
+        template<typename ...Args>
+        constexpr bool takes_rvalue_by_value(void*, std::tuple<Args...>*) noexcept
         {
-            detach(func, *obj);
+            return false;
         }
 
         /**
-         * \brief Dettach member function callback
+         * \brief Whether a subscriber takes by value an argument passed as an rvalue reference
+         *
+         * Every subscriber is passed the same object for such an argument, so
+         * the first one taking it by value would move it away from the rest.
+         * Subscribers whose parameters cannot be told are not rejected.
          */
-        template<typename TBase, typename TClass>
-        void detach(_TFunc TBase::* func, TClass& obj)
-        {
-            details::invokable_member<TRet, TClass, Args...> invokable(func, obj);
-            remove(invokable);
-        }
+        template<typename TSubscriber, typename ...Args>
+        constexpr bool takes_rvalue_by_value_v = takes_rvalue_by_value(
+            static_cast<typename parameters_of<TSubscriber>::type*>(nullptr), static_cast<std::tuple<Args...>*>(nullptr));
 
         /**
-         * \brief Dettach member function callback
+         * \brief Throw if a callable holds no target
          */
-        template<typename TBase, typename TClass>
-        void detach(_TFunc TBase::* func, TClass* obj)
+        template<typename TCallable>
+        void check_target(const TCallable& func)
         {
-            detach(func, *obj);
-        }
-
-    private:
-        std::list<std::shared_ptr<_TInvokable>> _invokables;
+            if constexpr (std::is_constructible<bool, const TCallable&>::value)
+            {
+                if (!static_cast<bool>(func))
+                    throw std::bad_function_call();
+            }
+        }
+
+        template<typename TClass, typename TMember> struct member_of;
+
+        /**
+         * \brief Member function pointer type rebound to a derived class
+         *
+         * Members taken through a base class convert to the same type as
+         * members taken through the class itself, so both compare equal.
+         */
+        template<typename TClass, typename TFunc, typename TBase>
+        struct member_of<TClass, TFunc TBase::*>
+        {
+            using type = TFunc std::remove_cv_t<TClass>::*;
+        };
+
+        template<typename TClass, typename TMember>
+        using member_of_t = typename member_of<TClass, TMember>::type;
+
+        /**
+         * \brief Signature-independent part of a delegate
+         *
+         * The identity of a delegate is its thunk, stored with its type
+         * erased, the object pointer and the bytes of the bound function
+         * pointer. Copying, comparing, hashing and counting references do not
+         * depend on the signature, so event storage keeps delegate_base and
+         * only the call goes through the typed delegate.
+         */
+        class delegate_base
+        {
+            struct _probe {};
+
+        protected:
+            using _TStorage = std::aligned_storage_t<sizeof(void (_probe::*)()), alignof(void (_probe::*)())>;
+            using _TErasedThunk = void(*)();
+
+        public:
+            /**
+             * \brief Add a reference to the closure of a delegate created by from_closure
+             */
+            void retain() const noexcept
+            {
+                static_cast<closure_base*>(_obj)->retain();
+            }
+
+            /**
+             * \brief Drop a reference to the closure of a delegate created by from_closure
+             */
+            void release() const noexcept
+            {
+                static_cast<closure_base*>(_obj)->release();
+            }
+
+            /**
+             * \brief Thunk of the delegate, to be cast back to the type of its signature
+             */
+            _TErasedThunk erased_thunk() const noexcept
+            {
+                return _thunk;
+            }
+
+            void* object() const noexcept
+            {
+                return _obj;
+            }
+
+            /**
+             * \brief Address of the bound function pointer or of a callable stored inline
+             */
+            const void* data() const noexcept
+            {
+                return &_func;
+            }
+
+            template<typename TPayload>
+            TPayload payload() const noexcept
+            {
+                TPayload payload;
+                std::memcpy(&payload, &_func, sizeof(TPayload));
+
+                return payload;
+            }
+
+            friend bool operator== (const delegate_base& lhs, const delegate_base& rhs) noexcept
+            {
+                return lhs._thunk == rhs._thunk && lhs._obj == rhs._obj
+                    && std::memcmp(&lhs._func, &rhs._func, sizeof(_TStorage)) == 0;
+            }
+
+            friend bool operator!= (const delegate_base& lhs, const delegate_base& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+
+            /**
+             * \brief Hash of the delegate identity, consistent with operator==
+             */
+            std::size_t hash() const noexcept
+            {
+                std::uintptr_t words[sizeof(delegate_base) / sizeof(std::uintptr_t)];
+                std::memcpy(words, this, sizeof(words));
+
+                std::size_t seed = 0;
+
+                for (auto word : words)
+                {
+                    seed ^= std::hash<std::uintptr_t>()(word) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                }
+
+                return seed;
+            }
+
+        protected:
+            delegate_base(_TErasedThunk thunk, void* obj) noexcept : _thunk(thunk), _obj(obj)
+            {
+                std::memset(&_func, 0, sizeof(_TStorage));
+            }
+
+            template<typename TFuncPtr>
+            void store(const TFuncPtr& func) noexcept
+            {
+                static_assert(sizeof(TFuncPtr) <= sizeof(_TStorage), "function pointer does not fit in a delegate");
+                std::memcpy(&_func, &func, sizeof(TFuncPtr));
+            }
+
+        private:
+            _TErasedThunk _thunk;
+            void* _obj;
+            _TStorage _func;
+        };
+
+        template<typename TFunc> class delegate;
+
+        /**
+         * \brief Non-virtual, trivially copyable callable reference
+         *
+         * A delegate is a thunk, an optional object pointer and the bytes of
+         * the bound function pointer. The thunk restores the original types
+         * and performs the call, so invoking a delegate is a single indirect
+         * call without a virtual dispatch or null checks. Only the thunks and
+         * the factories depend on the signature; everything else is shared
+         * through delegate_base.
+         */
+        template<typename TRet, typename ...Args>
+        class delegate<TRet(Args...)> : public delegate_base
+        {
+            using _TFuncPtr = typename std::add_pointer<TRet(Args...)>::type;
+            using _TThunk = TRet(*)(const delegate_base&, Args&&...);
+
+        public:
+            /**
+             * \brief Create delegate calling a function or a static member function
+             */
+            static delegate from_function(_TFuncPtr func)
+            {
+                if (func == nullptr)
+                    throw std::bad_function_call();
+
+                delegate d(&invoke_function, nullptr);
+                d.store(func);
+
+                return d;
+            }
+
+            /**
+             * \brief Create delegate calling a member function on an object
+             *
+             * Accepts const, noexcept and lvalue ref-qualified member functions
+             * and members of base classes of TClass.
+             */
+            template<typename TClass, typename TMember>
+            static delegate from_member(TMember func, TClass& obj)
+            {
+                static_assert(std::is_member_function_pointer<TMember>::value, "callback is not a member function");
+                check_parameters<TMember>();
+
+                if (func == nullptr)
+                    throw std::bad_function_call();
+
+                delegate d(&invoke_member<TClass, member_of_t<TClass, TMember>>, address(obj));
+                d.store(static_cast<member_of_t<TClass, TMember>>(func));
+
+                return d;
+            }
+
+            /**
+             * \brief Create delegate calling a function known at compile time
+             */
+            template<auto TFunc>
+            static delegate from_function() noexcept
+            {
+                static_assert(std::is_convertible<decltype(TFunc), _TFuncPtr>::value,
+                    "callback does not match the event signature");
+
+                return delegate(&invoke_bound_function<TFunc>, nullptr);
+            }
+
+            /**
+             * \brief Create delegate calling a member function known at compile time
+             */
+            template<auto TFunc, typename TClass>
+            static delegate from_member(TClass& obj) noexcept
+            {
+                static_assert(std::is_member_function_pointer<decltype(TFunc)>::value,
+                    "callback is not a member function");
+                check_parameters<decltype(TFunc)>();
+
+                return delegate(&invoke_bound_member<TFunc, TClass>, address(obj));
+            }
+
+            /**
+             * \brief Whether a callable is stored in the delegate itself
+             *
+             * Trivially copyable callables of up to two pointers that can be
+             * called as const are copied into the delegate; other callables
+             * are kept in a closure.
+             */
+            template<typename TCallable>
+            static constexpr bool stores_inline = std::is_trivially_copyable<TCallable>::value
+                && sizeof(TCallable) <= sizeof(_TStorage) && alignof(TCallable) <= alignof(_TStorage)
+                && std::is_invocable_r<TRet, const TCallable&, Args...>::value;
+
+            /**
+             * \brief Create delegate storing a small callable in place
+             */
+            template<typename TCallable>
+            static delegate from_callable(const TCallable& func)
+            {
+                static_assert(stores_inline<TCallable>, "callable does not fit in a delegate");
+                check_parameters<TCallable>();
+
+                check_target(func);
+
+                delegate d(&invoke_inline<TCallable>, nullptr);
+                d.store(func);
+
+                return d;
+            }
+
+            /**
+             * \brief Create delegate calling a callable kept in a closure
+             *
+             * The delegate does not own the closure; its holder manages the
+             * references through retain and release.
+             */
+            template<typename TCallable>
+            static delegate from_closure(closure<TCallable>& c)
+            {
+                check_parameters<TCallable>();
+                check_target(c.func);
+
+                return delegate(&invoke_closure<TCallable>, static_cast<void*>(static_cast<closure_base*>(&c)));
+            }
+
+            /**
+             * \brief Create delegate from a custom thunk and its payload
+             */
+            template<typename TPayload>
+            static delegate make(_TThunk thunk, void* obj, const TPayload& payload) noexcept
+            {
+                static_assert(std::is_trivially_copyable<TPayload>::value, "payload must be trivially copyable");
+
+                delegate d(thunk, obj);
+                d.store(payload);
+
+                return d;
+            }
+
+            /**
+             * \brief Call a delegate of this signature kept as delegate_base
+             */
+            static TRet call(const delegate_base& d, Args&&... args)
+            {
+                return thunk(d)(d, std::forward<Args>(args)...);
+            }
+
+            /**
+             * \brief Thunk of a delegate of this signature kept as delegate_base
+             */
+            static _TThunk thunk(const delegate_base& d) noexcept
+            {
+                return reinterpret_cast<_TThunk>(d.erased_thunk());
+            }
+
+            TRet operator() (Args&&... args) const
+            {
+                return call(*this, std::forward<Args>(args)...);
+            }
+
+            _TThunk thunk() const noexcept
+            {
+                return thunk(*this);
+            }
+
+        private:
+            delegate(_TThunk thunk, void* obj) noexcept : delegate_base(reinterpret_cast<_TErasedThunk>(thunk), obj)
+            {
+            }
+
+            template<typename TSubscriber>
+            static constexpr void check_parameters() noexcept
+            {
+                static_assert(!takes_rvalue_by_value_v<TSubscriber, Args...>,
+                    "arguments passed as rvalue references are shared by all subscribers, take them by reference");
+            }
+
+            template<typename TClass>
+            static void* address(TClass& obj) noexcept
+            {
+                return const_cast<void*>(static_cast<const volatile void*>(std::addressof(obj)));
+            }
+
+            static TRet invoke_function(const delegate_base& d, Args&&... args)
+            {
+                return d.payload<_TFuncPtr>()(std::forward<Args>(args)...);
+            }
+
+            template<typename TClass, typename TMember>
+            static TRet invoke_member(const delegate_base& d, Args&&... args)
+            {
+                auto func = d.payload<TMember>();
+
+                if constexpr (std::is_void<TRet>::value)
+                    (static_cast<TClass*>(d.object())->*func)(std::forward<Args>(args)...);
+                else
+                    return (static_cast<TClass*>(d.object())->*func)(std::forward<Args>(args)...);
+            }
+
+            template<auto TFunc>
+            static TRet invoke_bound_function(const delegate_base&, Args&&... args)
+            {
+                if constexpr (std::is_void<TRet>::value)
+                    TFunc(std::forward<Args>(args)...);
+                else
+                    return TFunc(std::forward<Args>(args)...);
+            }
+
+            template<auto TFunc, typename TClass>
+            static TRet invoke_bound_member(const delegate_base& d, Args&&... args)
+            {
+                if constexpr (std::is_void<TRet>::value)
+                    (static_cast<TClass*>(d.object())->*TFunc)(std::forward<Args>(args)...);
+                else
+                    return (static_cast<TClass*>(d.object())->*TFunc)(std::forward<Args>(args)...);
+            }
+
+            template<typename TCallable>
+            static TRet invoke_inline(const delegate_base& d, Args&&... args)
+            {
+                const auto& func = *std::launder(static_cast<const TCallable*>(d.data()));
+
+                if constexpr (std::is_void<TRet>::value)
+                    std::invoke(func, std::forward<Args>(args)...);
+                else
+                    return std::invoke(func, std::forward<Args>(args)...);
+            }
+
+            template<typename TCallable>
+            static TRet invoke_closure(const delegate_base& d, Args&&... args)
+            {
+                auto& func = static_cast<closure<TCallable>*>(static_cast<closure_base*>(d.object()))->func;
+
+                if constexpr (std::is_void<TRet>::value)
+                    std::invoke(func, std::forward<Args>(args)...);
+                else
+                    return std::invoke(func, std::forward<Args>(args)...);
+            }
+        };
+
+        template<typename ...Args>
+        struct batch_item
+        {
+            struct type {};
+        };
+
+        template<typename TArg>
+        struct batch_item<TArg>
+        {
+            using type = std::decay_t<TArg>;
+        };
+
+        /**
+         * \brief Type of payload accepted by batch subscribers of an event taking Args
+         */
+        template<typename ...Args>
+        using batch_item_t = typename batch_item<Args...>::type;
+
+        template<typename ...Args>
+        class batch_adapter
+        {
+        };
+
+        /**
+         * \brief Builds delegates for subscribers accepting a whole batch of payloads
+         *
+         * The delegate thunk is shared by all batch subscribers of a signature,
+         * which is how a dispatch over a batch recognises them. Notified with a
+         * single payload they receive a batch of one.
+         */
+        template<typename TArg>
+        class batch_adapter<TArg>
+        {
+            using _TItem = std::decay_t<TArg>;
+            using _TDelegate = delegate<void(TArg)>;
+            using _TFuncPtr = void(*)(span<const _TItem>);
+
+            static_assert(std::is_convertible<const _TItem&, TArg>::value,
+                "batch notification requires an argument taken by value or by const reference");
+
+            struct target
+            {
+                void (*invoke)(void*, _TFuncPtr, span<const _TItem>);
+                _TFuncPtr func;
+            };
+
+        public:
+            static _TDelegate from_function(_TFuncPtr func)
+            {
+                if (func == nullptr)
+                    throw std::bad_function_call();
+
+                return _TDelegate::make(&invoke_single, nullptr, target{ &call_function, func });
+            }
+
+            template<auto TFunc>
+            static _TDelegate from_function() noexcept
+            {
+                static_assert(std::is_convertible<decltype(TFunc), _TFuncPtr>::value,
+                    "callback does not accept a batch of event payloads");
+
+                return _TDelegate::make(&invoke_single, nullptr, target{ &call_bound_function<TFunc>, nullptr });
+            }
+
+            template<auto TFunc, typename TClass>
+            static _TDelegate from_member(TClass& obj) noexcept
+            {
+                static_assert(std::is_member_function_pointer<decltype(TFunc)>::value,
+                    "callback is not a member function");
+
+                return _TDelegate::make(&invoke_single, static_cast<void*>(std::addressof(obj)),
+                    target{ &call_bound_member<TFunc, TClass>, nullptr });
+            }
+
+            static bool is_batch(const delegate_base& d) noexcept
+            {
+                return _TDelegate::thunk(d) == &invoke_single;
+            }
+
+            /**
+             * \brief Pass a whole batch to a delegate built by this adapter
+             */
+            static void call(const delegate_base& d, span<const _TItem> items)
+            {
+                auto t = d.template payload<target>();
+                t.invoke(d.object(), t.func, items);
+            }
+
+        private:
+            static void invoke_single(const delegate_base& d, TArg&& arg)
+            {
+                call(d, span<const _TItem>(std::addressof(arg), 1));
+            }
+
+            static void call_function(void*, _TFuncPtr func, span<const _TItem> items)
+            {
+                func(items);
+            }
+
+            template<auto TFunc>
+            static void call_bound_function(void*, _TFuncPtr, span<const _TItem> items)
+            {
+                TFunc(items);
+            }
+
+            template<auto TFunc, typename TClass>
+            static void call_bound_member(void* obj, _TFuncPtr, span<const _TItem> items)
+            {
+                (static_cast<TClass*>(obj)->*TFunc)(items);
+            }
+        };
+
+        template<typename T, std::size_t N>
+        class inline_buffer
+        {
+        public:
+            T* data() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(&_buffer));
+            }
+
+        private:
+            std::aligned_storage_t<sizeof(T) * N, alignof(T)> _buffer;
+        };
+
+        template<typename T>
+        class inline_buffer<T, 0>
+        {
+        public:
+            T* data() noexcept
+            {
+                return nullptr;
+            }
+        };
+
+        /**
+         * \brief Contiguous container keeping up to N elements inside the object
+         *
+         * Elements live in the inline buffer until it is exhausted, after which
+         * they are relocated to a heap block allocated from a memory resource.
+         * With N equal to 0 it behaves like a plain vector. As with std::pmr
+         * containers, a copy uses the default resource and a move keeps the
+         * resource of its source.
+         */
+        template<typename T, std::size_t N>
+        class small_vector : private inline_buffer<T, N>
+        {
+            using _TBuffer = inline_buffer<T, N>;
+
+        public:
+            using value_type = T;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            small_vector() noexcept : _data(_TBuffer::data()), _size(0), _capacity(N)
+            {
+            }
+
+            explicit small_vector(std::pmr::memory_resource* resource) noexcept
+                : _data(_TBuffer::data()), _size(0), _capacity(N), _allocator(resource)
+            {
+            }
+
+            small_vector(const small_vector& other) : small_vector()
+            {
+                reserve(other._size);
+
+                for (const auto& value : other)
+                {
+                    emplace_back(value);
+                }
+            }
+
+            small_vector(small_vector&& other) : small_vector(other.resource())
+            {
+                take(std::move(other));
+            }
+
+            small_vector& operator= (const small_vector& other)
+            {
+                if (this != &other)
+                {
+                    clear();
+                    reserve(other._size);
+
+                    for (const auto& value : other)
+                    {
+                        emplace_back(value);
+                    }
+                }
+
+                return *this;
+            }
+
+            small_vector& operator= (small_vector&& other)
+            {
+                if (this != &other && _allocator == other._allocator)
+                {
+                    clear();
+                    release();
+                    take(std::move(other));
+                }
+                else if (this != &other)
+                {
+                    clear();
+                    reserve(other._size);
+
+                    for (auto& value : other)
+                    {
+                        emplace_back(std::move(value));
+                    }
+
+                    other.clear();
+                }
+
+                return *this;
+            }
+
+            ~small_vector()
+            {
+                clear();
+                release();
+            }
+
+            iterator begin() noexcept { return _data; }
+            iterator end() noexcept { return _data + _size; }
+            const_iterator begin() const noexcept { return _data; }
+            const_iterator end() const noexcept { return _data + _size; }
+
+            T* data() noexcept { return _data; }
+            const T* data() const noexcept { return _data; }
+
+            T& operator[] (std::size_t idx) noexcept { return _data[idx]; }
+            const T& operator[] (std::size_t idx) const noexcept { return _data[idx]; }
+
+            std::size_t size() const noexcept { return _size; }
+            std::size_t capacity() const noexcept { return _capacity; }
+            bool empty() const noexcept { return _size == 0; }
+
+            std::pmr::memory_resource* resource() const noexcept
+            {
+                return _allocator.resource();
+            }
+
+            /**
+             * \brief Check whether elements are kept in the inline buffer
+             */
+            bool is_inline() const noexcept
+            {
+                return N > 0 && _data == const_cast<small_vector*>(this)->_TBuffer::data();
+            }
+
+            void reserve(std::size_t capacity)
+            {
+                if (capacity > _capacity)
+                {
+                    relocate(capacity);
+                }
+            }
+
+            template<typename ...TArgs>
+            T& emplace_back(TArgs&&... args)
+            {
+                if (_size == _capacity)
+                {
+                    // construct first, the arguments may refer to an element
+                    std::size_t capacity = _capacity ? 2 * _capacity : 1;
+                    T* data = _allocator.allocate(capacity);
+
+                    try
+                    {
+                        new (data + _size) T(std::forward<TArgs>(args)...);
+                    }
+                    catch (...)
+                    {
+                        _allocator.deallocate(data, capacity);
+                        throw;
+                    }
+
+                    move_to(data);
+                    release();
+                    _data = data;
+                    _capacity = capacity;
+                }
+                else
+                {
+                    new (_data + _size) T(std::forward<TArgs>(args)...);
+                }
+
+                return _data[_size++];
+            }
+
+            iterator erase(const_iterator pos)
+            {
+                auto it = const_cast<iterator>(pos);
+                std::move(it + 1, end(), it);
+                _data[--_size].~T();
+
+                return it;
+            }
+
+            void pop_back() noexcept
+            {
+                _data[--_size].~T();
+            }
+
+            void clear() noexcept
+            {
+                std::destroy(begin(), end());
+                _size = 0;
+            }
+
+        private:
+            T* _data;
+            std::size_t _size;
+            std::size_t _capacity;
+            std::pmr::polymorphic_allocator<T> _allocator;
+
+            void move_to(T* data)
+            {
+                std::uninitialized_move(begin(), end(), data);
+                std::destroy(begin(), end());
+            }
+
+            void relocate(std::size_t capacity)
+            {
+                T* data = _allocator.allocate(capacity);
+
+                try
+                {
+                    move_to(data);
+                }
+                catch (...)
+                {
+                    _allocator.deallocate(data, capacity);
+                    throw;
+                }
+
+                release();
+                _data = data;
+                _capacity = capacity;
+            }
+
+            void release() noexcept
+            {
+                if (_data != _TBuffer::data())
+                {
+                    _allocator.deallocate(_data, _capacity);
+                }
+
+                _data = _TBuffer::data();
+                _capacity = N;
+            }
+
+            void take(small_vector&& other)
+            {
+                if (other._data != other._TBuffer::data())
+                {
+                    _data = other._data;
+                    _size = other._size;
+                    _capacity = other._capacity;
+                    other._data = other._TBuffer::data();
+                    other._size = 0;
+                    other._capacity = N;
+                }
+                else
+                {
+                    std::uninitialized_move(other.begin(), other.end(), _data);
+                    _size = other._size;
+                    other.clear();
+                }
+            }
+        };
+
+        /**
+         * \brief Per-thread record of events currently being dispatched
+         *
+         * Frames form a stack on the dispatching thread, so a subscriber that
+         * modifies the event it is notified by can be detected without the
+         * event itself being written to, and without atomic operations.
+         */
+        class dispatch_frame
+        {
+        public:
+            explicit dispatch_frame(const void* owner) noexcept : _owner(owner), _previous(_top)
+            {
+                _top = this;
+            }
+
+            dispatch_frame(const dispatch_frame&) = delete;
+            dispatch_frame& operator= (const dispatch_frame&) = delete;
+
+            ~dispatch_frame()
+            {
+                _top = _previous;
+            }
+
+            /**
+             * \brief Check whether owner is being dispatched on the calling thread
+             */
+            static bool active(const void* owner) noexcept
+            {
+                return find(owner, _top);
+            }
+
+            /**
+             * \brief Check whether owner is dispatched by a frame enclosing this one
+             */
+            bool nested() const noexcept
+            {
+                return find(_owner, _previous);
+            }
+
+        private:
+            const void* _owner;
+            dispatch_frame* _previous;
+
+            static inline thread_local dispatch_frame* _top = nullptr;
+
+            static bool find(const void* owner, const dispatch_frame* frame) noexcept
+            {
+                for (; frame != nullptr; frame = frame->_previous)
+                {
+                    if (frame->_owner == owner)
+                        return true;
+                }
+
+                return false;
+            }
+        };
+
+        /**
+         * \brief Holds the instrumentation policy of an event, empty when it is disabled
+         */
+        template<typename TInstrument, bool = TInstrument::enabled>
+        class instrumented
+        {
+        };
+
+        template<typename TInstrument>
+        class instrumented<TInstrument, true>
+        {
+        public:
+            /**
+             * \brief Policy receiving the measurements of the event
+             *
+             * The policy belongs to the event object: copies and moves of the
+             * event start with a default constructed one. Its hooks are called
+             * by the const dispatch methods, concurrently when the event is
+             * notified from several threads.
+             */
+            TInstrument& instrumentation() noexcept
+            {
+                return _instrument;
+            }
+
+            const TInstrument& instrumentation() const noexcept
+            {
+                return _instrument;
+            }
+
+        protected:
+            /**
+             * \brief Policy written to by the const dispatch methods
+             */
+            TInstrument& instrument() const noexcept
+            {
+                return _instrument;
+            }
+
+        private:
+            mutable TInstrument _instrument;
+        };
+
+        /**
+         * \brief Times a single subscriber call, empty when instrumentation is disabled
+         */
+        template<typename TInstrument, bool = TInstrument::enabled>
+        struct call_probe
+        {
+        };
+
+        template<typename TInstrument>
+        class call_probe<TInstrument, true>
+        {
+        public:
+            call_probe(TInstrument& instrument, subscription subscriber) noexcept
+                : _instrument(instrument), _subscriber(subscriber), _start(TInstrument::clock::now())
+            {
+            }
+
+            call_probe(const call_probe&) = delete;
+            call_probe& operator= (const call_probe&) = delete;
+
+            ~call_probe()
+            {
+                _instrument.on_call(_subscriber, TInstrument::clock::now() - _start);
+            }
+
+        private:
+            TInstrument& _instrument;
+            subscription _subscriber;
+            typename TInstrument::clock::time_point _start;
+        };
+
+        /**
+         * \brief Chunks of a parallel notification, shared with the work items running them
+         *
+         * Work items and the notifying thread claim chunks until none is left,
+         * so the notification completes even if the executor never runs the
+         * work items. A work item run after the last chunk was claimed finds
+         * nothing to do and only touches this state, which it keeps alive.
+         */
+        class parallel_join
+        {
+        public:
+            explicit parallel_join(std::size_t chunks) noexcept : _chunks(chunks)
+            {
+            }
+
+            /**
+             * \brief Run chunks until every chunk has been claimed
+             */
+            template<typename TChunk>
+            void run(const TChunk& chunk) noexcept
+            {
+                for (auto index = _next.fetch_add(1); index < _chunks; index = _next.fetch_add(1))
+                {
+                    try
+                    {
+                        chunk(index);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+
+                        if (!_error)
+                            _error = std::current_exception();
+                    }
+
+                    if (_done.fetch_add(1) + 1 == _chunks)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _finished.notify_all();
+                    }
+                }
+            }
+
+            /**
+             * \brief Wait until every chunk has completed, rethrowing the first exception
+             */
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _finished.wait(lock, [this] { return _done.load() == _chunks; });
+
+                if (_error)
+                    std::rethrow_exception(_error);
+            }
+
+        private:
+            std::size_t _chunks;
+            std::atomic<std::size_t> _next{ 0 };
+            std::atomic<std::size_t> _done{ 0 };
+            std::mutex _mutex;
+            std::condition_variable _finished;
+            std::exception_ptr _error;
+        };
+
+#ifdef EVENTCPP_COROUTINES
+        /**
+         * \brief Awaiter resuming a coroutine with the arguments of the next notification
+         *
+         * The awaiter lives in the coroutine frame and attaches a subscriber
+         * holding a pointer to itself, which fits in the delegate, so waiting
+         * allocates nothing beyond the slot. The coroutine is resumed inside
+         * the notification, before the remaining subscribers are called.
+         */
+        template<typename TEvent, bool TNoexcept, typename ...Args>
+        class next_awaiter
+        {
+            using _TArgs = std::tuple<std::decay_t<Args>...>;
+
+        public:
+            explicit next_awaiter(TEvent& e) noexcept : _event(e)
+            {
+            }
+
+            next_awaiter(const next_awaiter&) = delete;
+            next_awaiter& operator= (const next_awaiter&) = delete;
+
+            /**
+             * \brief Detach the subscriber of a coroutine destroyed while waiting
+             */
+            ~next_awaiter()
+            {
+                if (_handle.valid())
+                    _event.detach(_handle);
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> awaiting)
+            {
+                _awaiting = awaiting;
+                _handle = _event.attach([this](Args... args) noexcept(TNoexcept)
+                {
+                    resume(std::forward<Args>(args)...);
+                });
+            }
+
+            _TArgs await_resume()
+            {
+                return std::move(*_args);
+            }
+
+        private:
+            TEvent& _event;
+            subscription _handle;
+            std::coroutine_handle<> _awaiting;
+            std::optional<_TArgs> _args;
+
+            void resume(Args... args) noexcept(TNoexcept)
+            {
+                _args.emplace(std::forward<Args>(args)...);
+                _event.detach(std::exchange(_handle, subscription()));
+                _awaiting.resume();
+            }
+        };
+
+        /**
+         * \brief Subscriber buffering notifications for a coroutine awaiting them in turn
+         *
+         * Stays attached from construction to destruction, so no notification
+         * is missed between two awaits; notifications made while the coroutine
+         * is busy are queued and returned by the following awaits.
+         */
+        template<typename TEvent, bool TNoexcept, typename ...Args>
+        class event_stream
+        {
+            using _TArgs = std::tuple<std::decay_t<Args>...>;
+
+        public:
+            class awaiter
+            {
+            public:
+                explicit awaiter(event_stream& stream) noexcept : _stream(stream)
+                {
+                }
+
+                bool await_ready() const noexcept
+                {
+                    return !_stream._queue.empty();
+                }
+
+                void await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    _stream._awaiting = awaiting;
+                }
+
+                _TArgs await_resume()
+                {
+                    _TArgs args = std::move(_stream._queue.front());
+                    _stream._queue.pop_front();
+
+                    return args;
+                }
+
+            private:
+                event_stream& _stream;
+            };
+
+            explicit event_stream(TEvent& e) : _event(e), _queue(e.resource())
+            {
+                _handle = _event.attach([this](Args... args) noexcept(TNoexcept)
+                {
+                    push(std::forward<Args>(args)...);
+                });
+            }
+
+            event_stream(const event_stream&) = delete;
+            event_stream& operator= (const event_stream&) = delete;
+
+            ~event_stream()
+            {
+                _event.detach(_handle);
+            }
+
+            /**
+             * \brief Await the oldest notification not returned yet
+             *
+             * Only one coroutine may await a stream at a time.
+             */
+            awaiter next() noexcept
+            {
+                return awaiter(*this);
+            }
+
+            /**
+             * \brief Number of notifications queued for the following awaits
+             */
+            std::size_t size() const noexcept
+            {
+                return _queue.size();
+            }
+
+        private:
+            TEvent& _event;
+            subscription _handle;
+            std::coroutine_handle<> _awaiting;
+            std::pmr::deque<_TArgs> _queue;
+
+            void push(Args... args) noexcept(TNoexcept)
+            {
+                _queue.emplace_back(std::forward<Args>(args)...);
+
+                if (_awaiting)
+                    std::exchange(_awaiting, nullptr).resume();
+            }
+        };
+#endif
+
+        /**
+         * \brief Subscriber sealed into a frozen event, in notification order
+         */
+        template<typename TDelegate>
+        struct frozen_slot
+        {
+            TDelegate invokable;
+            guard_base* guard;
+            int priority;
+            bool owning;
+        };
+
+        template<typename TFunc, bool TNoexcept> class basic_frozen_event;
+
+        /**
+         * \brief Immutable set of subscribers sealed from an event
+         *
+         * Delegates are packed into one array starting on a cache line and
+         * never written after construction; references to callables kept in
+         * closures and to guards of tracked subscribers are held in a second
+         * array, allocated only if there are any. Notifying reads the arrays
+         * only, so a frozen event may be notified from any number of threads
+         * at once without synchronization.
+         */
+        template<typename TRet, typename ...Args, bool TNoexcept>
+        class basic_frozen_event<TRet(Args...), TNoexcept>
+        {
+            using _TDelegate = delegate<TRet(Args...)>;
+            using _TSlot = frozen_slot<delegate_base>;
+
+            static constexpr std::size_t _cache_line = 64;
+
+            /**
+             * \brief References a sealed subscriber holds
+             */
+            struct anchor
+            {
+                guard_base* guard;
+                bool owning;
+            };
+
+        public:
+            /**
+             * \brief Seal subscribers, taking a reference to their closures and guards
+             */
+            basic_frozen_event(span<const _TSlot> slots, std::pmr::memory_resource* resource)
+                : _resource(resource), _size(slots.size())
+            {
+                allocate();
+
+                for (std::size_t i = 0; i < _size; i++)
+                {
+                    new (&_invokables[i]) delegate_base(slots[i].invokable);
+                    _guarded = _guarded || slots[i].guard != nullptr;
+                }
+
+                auto anchored = std::any_of(slots.begin(), slots.end(), [](const _TSlot& slot)
+                {
+                    return slot.guard != nullptr || slot.owning;
+                });
+
+                if (anchored)
+                {
+                    allocate_anchors();
+
+                    for (std::size_t i = 0; i < _size; i++)
+                    {
+                        _anchors[i] = anchor{ slots[i].guard, slots[i].owning };
+                    }
+
+                    retain();
+                }
+            }
+
+            basic_frozen_event(const basic_frozen_event& other)
+                : _resource(other._resource), _size(other._size), _guarded(other._guarded)
+            {
+                allocate();
+
+                if (_size != 0)
+                    std::memcpy(static_cast<void*>(_invokables), other._invokables, sizeof(delegate_base) * _size);
+
+                if (other._anchors != nullptr)
+                {
+                    allocate_anchors();
+                    std::copy(other._anchors, other._anchors + _size, _anchors);
+
+                    retain();
+                }
+            }
+
+            basic_frozen_event(basic_frozen_event&& other) noexcept
+                : _resource(other._resource), _invokables(std::exchange(other._invokables, nullptr)),
+                _anchors(std::exchange(other._anchors, nullptr)), _size(std::exchange(other._size, 0)),
+                _guarded(std::exchange(other._guarded, false))
+            {
+            }
+
+            basic_frozen_event& operator= (const basic_frozen_event& other)
+            {
+                if (this != &other)
+                {
+                    *this = basic_frozen_event(other);
+                }
+
+                return *this;
+            }
+
+            basic_frozen_event& operator= (basic_frozen_event&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+
+                    _resource = other._resource;
+                    _invokables = std::exchange(other._invokables, nullptr);
+                    _anchors = std::exchange(other._anchors, nullptr);
+                    _size = std::exchange(other._size, 0);
+                    _guarded = std::exchange(other._guarded, false);
+                }
+
+                return *this;
+            }
+
+            ~basic_frozen_event()
+            {
+                release();
+            }
+
+            /**
+             * \brief Notify the sealed subscribers
+             *
+             * Arguments are passed as by notifying an event; subscribers whose
+             * tracked object has been destroyed are skipped.
+             *
+             * \param args arguments that will be passed to subscribed callbacks
+             * \return value returned by the last subscriber, a value-initialized
+             *         TRet if there is none
+             */
+            template<typename _TRet = TRet>
+            std::enable_if_t<!std::is_same<_TRet, void>::value, _TRet>
+                operator() (Args... args) const noexcept(TNoexcept)
+            {
+                if constexpr (std::is_same<_TRet, dispatch_result>::value)
+                    return dispatch<until_stop>(std::forward<Args>(args)...);
+
+                if (_size == 0)
+                    return empty_result<_TRet>();
+
+                auto last = _size - 1;
+
+                for (std::size_t i = 0; i < last; i++)
+                {
+                    if (notifiable(i))
+                        _TDelegate::call(_invokables[i], forward_copy<Args>(args)...);
+                }
+
+                if (!notifiable(last))
+                    return empty_result<_TRet>();
+
+                return _TDelegate::call(_invokables[last], std::forward<Args>(args)...);
+            }
+
+            template<typename _TRet = TRet>
+            std::enable_if_t<std::is_same<_TRet, void>::value, _TRet>
+                operator() (Args... args) const noexcept(TNoexcept)
+            {
+                if (_size == 0)
+                    return;
+
+                auto last = _size - 1;
+
+                for (std::size_t i = 0; i < last; i++)
+                {
+                    if (notifiable(i))
+                        _TDelegate::call(_invokables[i], forward_copy<Args>(args)...);
+                }
+
+                if (notifiable(last))
+                    _TDelegate::call(_invokables[last], std::forward<Args>(args)...);
+            }
+
+            /**
+             * \brief Notify the sealed subscribers until the policy stops propagation
+             *
+             * \tparam TPolicy policy such as until_false, until_true or until_stop
+             */
+            template<typename TPolicy>
+            TRet dispatch(Args... args) const noexcept(TNoexcept)
+            {
+                static_assert(!std::is_same<TRet, void>::value, "propagation of void subscribers cannot be stopped");
+
+                if (_size == 0)
+                    return empty_result<TRet>();
+
+                auto last = _size - 1;
+
+                for (std::size_t i = 0; i < last; i++)
+                {
+                    if (notifiable(i))
+                    {
+                        TRet result = _TDelegate::call(_invokables[i], forward_copy<Args>(args)...);
+
+                        if (!TPolicy::proceed(result))
+                            return result;
+                    }
+                }
+
+                if (!notifiable(last))
+                    return empty_result<TRet>();
+
+                return _TDelegate::call(_invokables[last], std::forward<Args>(args)...);
+            }
+
+            /**
+             * \brief Notify the sealed subscribers and combine their results
+             *
+             * \param combiner object with bool operator() (TRet) and result()
+             */
+            template<typename TCombiner>
+            auto invoke(TCombiner&& combiner, Args... args) const -> decltype(combiner.result())
+            {
+                static_assert(!std::is_same<TRet, void>::value, "results of void subscribers cannot be combined");
+
+                if (_size != 0)
+                {
+                    auto last = _size - 1;
+
+                    for (std::size_t i = 0; i < last; i++)
+                    {
+                        if (notifiable(i) && !combiner(_TDelegate::call(_invokables[i], forward_copy<Args>(args)...)))
+                            return combiner.result();
+                    }
+
+                    if (notifiable(last))
+                        combiner(_TDelegate::call(_invokables[last], std::forward<Args>(args)...));
+                }
+
+                return combiner.result();
+            }
+
+            /**
+             * \brief Number of sealed subscribers, expired ones included
+             */
+            std::size_t size() const noexcept
+            {
+                return _size;
+            }
+
+            bool empty() const noexcept
+            {
+                return _size == 0;
+            }
+
+            /**
+             * \brief Memory resource the event allocates from
+             */
+            std::pmr::memory_resource* resource() const noexcept
+            {
+                return _resource;
+            }
+
+        private:
+            std::pmr::memory_resource* _resource;
+            delegate_base* _invokables = nullptr;
+            anchor* _anchors = nullptr;
+            std::size_t _size;
+
+            /**
+             * \brief Whether any subscriber is checked for expiry before being notified
+             */
+            bool _guarded = false;
+
+            bool notifiable(std::size_t i) const noexcept
+            {
+                return !_guarded || _anchors[i].guard == nullptr || !_anchors[i].guard->expired();
+            }
+
+            std::size_t storage() const noexcept
+            {
+                return (sizeof(delegate_base) * _size + _cache_line - 1) / _cache_line * _cache_line;
+            }
+
+            void allocate()
+            {
+                if (_size != 0)
+                    _invokables = static_cast<delegate_base*>(_resource->allocate(storage(), _cache_line));
+            }
+
+            void allocate_anchors()
+            {
+                try
+                {
+                    _anchors = static_cast<anchor*>(_resource->allocate(sizeof(anchor) * _size, alignof(anchor)));
+                }
+                catch (...)
+                {
+                    _resource->deallocate(_invokables, storage(), _cache_line);
+                    throw;
+                }
+            }
+
+            void retain() const noexcept
+            {
+                for (std::size_t i = 0; i < _size; i++)
+                {
+                    if (_anchors[i].owning)
+                        _invokables[i].retain();
+
+                    if (_anchors[i].guard != nullptr)
+                        _anchors[i].guard->retain();
+                }
+            }
+
+            void release() noexcept
+            {
+                if (_anchors != nullptr)
+                {
+                    for (std::size_t i = 0; i < _size; i++)
+                    {
+                        if (_anchors[i].owning)
+                            _invokables[i].release();
+
+                        if (_anchors[i].guard != nullptr)
+                            _anchors[i].guard->release();
+                    }
+
+                    _resource->deallocate(_anchors, sizeof(anchor) * _size, alignof(anchor));
+                    _anchors = nullptr;
+                }
+
+                if (_invokables != nullptr)
+                {
+                    _resource->deallocate(_invokables, storage(), _cache_line);
+                    _invokables = nullptr;
+                }
+
+                _size = 0;
+            }
+        };
+
+        template<typename TDelegate>
+        struct subscriber_slot
+        {
+            TDelegate invokable;
+            std::uint32_t id;
+            bool alive;
+            bool owning;
+            bool guarded;
+        };
+
+        struct subscription_entry
+        {
+            std::uint32_t position;
+            std::uint32_t generation;
+            int priority;
+            guard_base* guard;
+        };
+
+        /**
+         * \brief Attach and detach overloads shared by all event types
+         *
+         * Every overload builds a delegate and hands it to TDerived, which
+         * implements storage through insert and remove. Subscribers attached
+         * with a higher priority are notified first, subscribers of equal
+         * priority in the order they were attached.
+         *
+         * Member functions of objects deriving from tracked, or given by a
+         * std::weak_ptr, are attached with a guard; they are not notified and
+         * are dropped once the object is destroyed.
+         *
+         * If TNoexcept is set only callbacks that do not throw are accepted.
+         */
+        template<typename TDerived, typename TFunc, bool TNoexcept = false> class subscribable;
+
+        template<typename TDerived, typename TRet, typename ...Args, bool TNoexcept>
+        class subscribable<TDerived, TRet(Args...), TNoexcept>
+        {
+            using _TFunc = TRet(Args...) noexcept(TNoexcept);
+            using _TFuncPtr = typename std::add_pointer<_TFunc>::type;
+            using _TDelegate = delegate<TRet(Args...)>;
+
+        public:
+            /**
+             * \brief Attach function callback
+             */
+            subscription attach(_TFuncPtr func, int priority = 0)
+            {
+                return derived().insert(_TDelegate::from_function(func), priority);
+            }
+
+            /**
+             * \brief Attach member function callback
+             */
+            template<typename TClass>
+            subscription attach(_TFunc TClass::* func, TClass& obj, int priority = 0)
+            {
+                return derived().insert(_TDelegate::template from_member<TClass>(func, obj), priority, false,
+                    tracked_access::guard(obj));
+            }
+
+            /**
+             * \brief Attach member function callback
+             */
+            template<typename TClass>
+            subscription attach(_TFunc TClass::* func, TClass* obj, int priority = 0)
+            {
+                return attach(func, *obj, priority);
+            }
+
+            /**
+             * \brief Attach member function callback
+             */
+            template<typename TBase, typename TClass, typename = std::enable_if_t<std::is_base_of<TBase, TClass>::value>>
+            subscription attach(_TFunc TBase::* func, TClass& obj, int priority = 0)
+            {
+                return derived().insert(_TDelegate::template from_member<TClass>(func, obj), priority, false,
+                    tracked_access::guard(obj));
+            }
+
+            /**
+             * \brief Attach member function callback
+             */
+            template<typename TBase, typename TClass>
+            subscription attach(_TFunc TBase::* func, TClass* obj, int priority = 0)
+            {
+                return attach(func, *obj, priority);
+            }
+
+            /**
+             * \brief Attach const, noexcept or ref-qualified member function callback
+             */
+            template<typename TMember, typename TClass,
+                typename = std::enable_if_t<is_member_callable_v<TNoexcept, TMember, TClass, TRet, Args...>>>
+            subscription attach(TMember func, TClass& obj, int priority = 0)
+            {
+                return derived().insert(_TDelegate::template from_member<TClass>(func, obj), priority, false,
+                    tracked_access::guard(obj));
+            }
+
+            /**
+             * \brief Attach const, noexcept or ref-qualified member function callback
+             */
+            template<typename TMember, typename TClass,
+                typename = std::enable_if_t<is_member_callable_v<TNoexcept, TMember, TClass, TRet, Args...>>>
+            subscription attach(TMember func, TClass* obj, int priority = 0)
+            {
+                return attach(func, *obj, priority);
+            }
+
+            /**
+             * \brief Attach member function callback of an object owned by a std::shared_ptr
+             *
+             * The subscriber is skipped and dropped once the object is destroyed.
+             *
+             * \throw std::bad_weak_ptr if the object no longer exists
+             */
+            template<typename TMember, typename TClass,
+                typename = std::enable_if_t<is_member_callable_v<TNoexcept, TMember, TClass, TRet, Args...>>>
+            subscription attach(TMember func, std::weak_ptr<TClass> obj, int priority = 0)
+            {
+                std::shared_ptr<TClass> target(obj);
+                std::unique_ptr<guard_base, guard_base::releaser> guard(new weak_guard<TClass>(std::move(obj)));
+
+                return derived().insert(_TDelegate::template from_member<TClass>(func, *target), priority, false,
+                    guard.get());
+            }
+
+            /**
+             * \brief Attach a lambda, a function object or any other callable
+             *
+             * The callable is copied or moved into the event. Small trivially
+             * copyable callables, such as lambdas capturing a pointer or two,
+             * are stored in the delegate; others are allocated from the memory
+             * resource of the event and freed once detached. Detach such subscribers by their handle.
+             */
+            template<typename TCallable, typename = std::enable_if_t<is_callable_v<TNoexcept, TCallable, TRet, Args...>>>
+            subscription attach(TCallable&& func, int priority = 0)
+            {
+                using _TCallable = std::decay_t<TCallable>;
+
+                if constexpr (_TDelegate::template stores_inline<_TCallable>)
+                {
+                    return derived().insert(_TDelegate::template from_callable<_TCallable>(func), priority);
+                }
+                else
+                {
+                    auto owner = closure<_TCallable>::create(derived().resource(), std::forward<TCallable>(func));
+                    auto handle = derived().insert(_TDelegate::from_closure(*owner), priority, true);
+                    owner.release();
+
+                    return handle;
+                }
+            }
+
+            /**
+             * \brief Attach function callback bound at compile time
+             *
+             * The callback is a template argument, so the generated thunk calls
+             * it directly and the call can be inlined.
+             */
+            template<auto TFunc>
+            subscription attach(int priority = 0)
+            {
+                static_assert(is_invocable_v<TNoexcept, TRet, decltype(TFunc), Args...>,
+                    "callback does not match the event signature");
+
+                return derived().insert(_TDelegate::template from_function<TFunc>(), priority);
+            }
+
+            /**
+             * \brief Attach member function callback bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            subscription attach(TClass& obj, int priority = 0)
+            {
+                static_assert(is_member_callable_v<TNoexcept, decltype(TFunc), TClass, TRet, Args...>,
+                    "callback does not match the event signature");
+
+                return derived().insert(_TDelegate::template from_member<TFunc, TClass>(obj), priority, false,
+                    tracked_access::guard(obj));
+            }
+
+            /**
+             * \brief Attach member function callback bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            subscription attach(TClass* obj, int priority = 0)
+            {
+                return this->template attach<TFunc>(*obj, priority);
+            }
+
+            /**
+             * \brief Attach member function callback bound at compile time of an object owned by a std::shared_ptr
+             *
+             * \throw std::bad_weak_ptr if the object no longer exists
+             */
+            template<auto TFunc, typename TClass>
+            subscription attach(std::weak_ptr<TClass> obj, int priority = 0)
+            {
+                static_assert(is_member_callable_v<TNoexcept, decltype(TFunc), TClass, TRet, Args...>,
+                    "callback does not match the event signature");
+
+                std::shared_ptr<TClass> target(obj);
+                std::unique_ptr<guard_base, guard_base::releaser> guard(new weak_guard<TClass>(std::move(obj)));
+
+                return derived().insert(_TDelegate::template from_member<TFunc, TClass>(*target), priority, false,
+                    guard.get());
+            }
+
+            /**
+             * \brief Dettach function callback
+             */
+            void detach(_TFuncPtr func)
+            {
+                derived().remove(_TDelegate::from_function(func));
+            }
+
+            /**
+             * \brief Dettach member function callback
+             */
+            template<typename TClass>
+            void detach(_TFunc TClass::* func, TClass& obj)
+            {
+                derived().remove(_TDelegate::template from_member<TClass>(func, obj));
+            }
+
+            /**
+             * \brief Dettach member function callback
+             */
+            template<typename TClass>
+            void detach(_TFunc TClass::* func, TClass* obj)
+            {
+                detach(func, *obj);
+            }
+
+            /**
+             * \brief Dettach member function callback
+             */
+            template<typename TBase, typename TClass, typename = std::enable_if_t<std::is_base_of<TBase, TClass>::value>>
+            void detach(_TFunc TBase::* func, TClass& obj)
+            {
+                derived().remove(_TDelegate::template from_member<TClass>(func, obj));
+            }
+
+            /**
+             * \brief Dettach member function callback
+             */
+            template<typename TBase, typename TClass>
+            void detach(_TFunc TBase::* func, TClass* obj)
+            {
+                detach(func, *obj);
+            }
+
+            /**
+             * \brief Dettach const, noexcept or ref-qualified member function callback
+             */
+            template<typename TMember, typename TClass,
+                typename = std::enable_if_t<is_member_callable_v<TNoexcept, TMember, TClass, TRet, Args...>>>
+            void detach(TMember func, TClass& obj)
+            {
+                derived().remove(_TDelegate::template from_member<TClass>(func, obj));
+            }
+
+            /**
+             * \brief Dettach const, noexcept or ref-qualified member function callback
+             */
+            template<typename TMember, typename TClass,
+                typename = std::enable_if_t<is_member_callable_v<TNoexcept, TMember, TClass, TRet, Args...>>>
+            void detach(TMember func, TClass* obj)
+            {
+                detach(func, *obj);
+            }
+
+            /**
+             * \brief Dettach function callback bound at compile time
+             */
+            template<auto TFunc>
+            void detach()
+            {
+                derived().remove(_TDelegate::template from_function<TFunc>());
+            }
+
+            /**
+             * \brief Dettach member function callback bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            void detach(TClass& obj)
+            {
+                derived().remove(_TDelegate::template from_member<TFunc, TClass>(obj));
+            }
+
+            /**
+             * \brief Dettach member function callback bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            void detach(TClass* obj)
+            {
+                this->template detach<TFunc>(*obj);
+            }
+
+            /**
+             * \brief Dettach subscriber identified by a handle returned from attach
+             *
+             * \return true if subscriber was attached and has been removed
+             */
+            bool detach(subscription handle)
+            {
+                return derived().remove(handle);
+            }
+
+        private:
+            TDerived& derived() noexcept
+            {
+                return static_cast<TDerived&>(*this);
+            }
+        };
+
+        /**
+         * \brief Subscriber storage shared by events of every signature
+         *
+         * Slots keep delegate_base, so attaching, detaching, ordering by
+         * priority, copying and releasing subscribers depend on N only and
+         * are compiled once for all signatures; basic_event adds the dispatch
+         * loops, which call the typed thunks. With EVENTCPP_COMPILED_CORE
+         * defined the core of event, N = 0, is compiled in the eventcpp_core
+         * library instead of in every translation unit.
+         *
+         * \tparam N number of subscribers stored without heap allocation
+         */
+        template<std::size_t N>
+        class event_core
+        {
+        public:
+            event_core() = default;
+
+            /**
+             * \brief Create event allocating its storage from a memory resource
+             *
+             * Subscriber storage, the detach index and callables kept on the heap
+             * are allocated from the resource, which must outlive the event.
+             * Copies of the event use the default resource.
+             */
+            explicit event_core(std::pmr::memory_resource* resource)
+                : _invokables(resource), _entries(resource), _index(resource), _pending(resource)
+            {
+            }
+
+            /**
+             * \brief Copy subscribers, sharing callables kept on the heap
+             */
+            event_core(const event_core& other)
+                : _invokables(other._invokables), _entries(other._entries), _free(other._free), _dead(other._dead),
+                _guarded(other._guarded), _expired(other._expired.load(std::memory_order_relaxed)),
+                _index(other._index), _indexed(other._indexed), _pending(other._pending)
+            {
+                for_each_slot([](const _TSlot& slot)
+                {
+                    if (slot.owning)
+                        slot.invokable.retain();
+                });
+
+                for (const auto& entry : _entries)
+                {
+                    if (entry.guard != nullptr)
+                        entry.guard->retain();
+                }
+            }
+
+            event_core(event_core&& other) noexcept
+                : _invokables(std::move(other._invokables)), _entries(std::move(other._entries)),
+                _free(std::exchange(other._free, _npos)), _dead(std::exchange(other._dead, 0)),
+                _guarded(std::exchange(other._guarded, 0)),
+                _expired(other._expired.exchange(false, std::memory_order_relaxed)), _index(std::move(other._index)),
+                _indexed(std::exchange(other._indexed, false)), _pending(std::move(other._pending))
+            {
+            }
+
+            event_core& operator= (const event_core& other)
+            {
+                if (this != &other)
+                {
+                    *this = event_core(other);
+                }
+
+                return *this;
+            }
+
+            event_core& operator= (event_core&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+
+                    _invokables = std::move(other._invokables);
+                    _entries = std::move(other._entries);
+                    _free = std::exchange(other._free, _npos);
+                    _dead = std::exchange(other._dead, 0);
+                    _guarded = std::exchange(other._guarded, 0);
+                    _expired.store(other._expired.exchange(false, std::memory_order_relaxed), std::memory_order_relaxed);
+                    _index = std::move(other._index);
+                    _indexed = std::exchange(other._indexed, false);
+                    _pending = std::move(other._pending);
+                }
+
+                return *this;
+            }
+
+            ~event_core()
+            {
+                release();
+            }
+
+            /**
+             * \brief Number of attached subscribers
+             */
+            std::size_t size() const noexcept
+            {
+                auto count = attached();
+
+                // expired tracked subscribers seen by a dispatch are dropped by the next attach or detach
+                if (_expired.load(std::memory_order_relaxed))
+                {
+                    for_each_slot([this, &count](const _TSlot& slot)
+                    {
+                        if (expired(slot))
+                            count--;
+                    });
+                }
+
+                return count;
+            }
+
+            /**
+             * \brief Memory resource the event allocates from
+             */
+            std::pmr::memory_resource* resource() const noexcept
+            {
+                return _invokables.resource();
+            }
+
+            bool empty() const noexcept
+            {
+                return size() == 0;
+            }
+
+        protected:
+            using _TSlot = subscriber_slot<delegate_base>;
+
+            static constexpr std::uint32_t _npos = ~std::uint32_t(0);
+
+            /**
+             * \brief Marks the position of a subscriber attached during a dispatch
+             */
+            static constexpr std::uint32_t _pending_bit = std::uint32_t(1) << 31;
+
+            static_assert(std::is_trivially_copyable<delegate_base>::value, "delegate must be trivially copyable");
+            static_assert(sizeof(delegate_base) % sizeof(std::uintptr_t) == 0, "delegate must not be padded");
+
+            /**
+             * \brief Number of subscribers from which detaching by callback uses a hash index
+             */
+            static constexpr std::size_t _index_threshold = 32;
+
+            small_vector<_TSlot, N> _invokables;
+            small_vector<subscription_entry, N> _entries;
+            std::uint32_t _free = _npos;
+            std::size_t _dead = 0;
+            std::size_t _guarded = 0;
+            mutable std::atomic<bool> _expired{ false };
+            std::pmr::unordered_multimap<std::size_t, std::uint32_t> _index;
+            bool _indexed = false;
+            small_vector<_TSlot, 0> _pending;
+
+            /**
+             * \brief Number of attached subscribers, expired ones included
+             */
+            std::size_t attached() const noexcept
+            {
+                return _invokables.size() + _pending.size() - _dead;
+            }
+
+            /**
+             * \brief Check whether a slot is to be notified
+             *
+             * A guarded slot whose object has been destroyed is skipped; the
+             * check only raises an atomic flag, so a const event may be
+             * notified from several threads at once.
+             */
+            bool notifiable(const _TSlot& slot) const noexcept
+            {
+                if (!slot.alive)
+                    return false;
+
+                if (!slot.guarded || !_entries[slot.id].guard->expired())
+                    return true;
+
+                // only a hint for the next attach or detach, which has the event to itself
+                if (!_expired.load(std::memory_order_relaxed))
+                    _expired.store(true, std::memory_order_relaxed);
+
+                return false;
+            }
+
+            bool expired(const _TSlot& slot) const noexcept
+            {
+                return slot.alive && slot.guarded && _entries[slot.id].guard->expired();
+            }
+
+            struct delegate_hash
+            {
+                std::size_t operator() (const delegate_base& d) const noexcept
+                {
+                    return d.hash();
+                }
+            };
+
+            /**
+             * \brief Position of the last slot to be notified
+             */
+            std::size_t last_alive() const noexcept
+            {
+                for (auto i = _invokables.size(); i > 0; i--)
+                {
+                    if (notifiable(_invokables[i - 1]))
+                        return i - 1;
+                }
+
+                return _npos;
+            }
+
+            /**
+             * \brief Insert a subscriber, deferring it while the event is being dispatched
+             *
+             * Subscribers attached during a dispatch are kept in a pending list,
+             * so the slots being iterated never move, and are placed once the
+             * outermost dispatch returns; they are first notified by the next
+             * notification. If inserting fails, the event is left unchanged and
+             * the caller still owns the callable and the guard.
+             */
+            subscription insert(const delegate_base& invokable, int priority, bool owning = false, guard_base* guard = nullptr)
+            {
+                drop_expired();
+
+                auto pending = dispatch_frame::active(this);
+                std::uint32_t id;
+
+                // subscribers left pending by a failed merge keep their place in order
+                if (!pending && !_pending.empty())
+                    merge();
+
+                if (_free != _npos)
+                {
+                    id = _free;
+                    _free = _entries[id].position;
+                }
+                else
+                {
+                    id = static_cast<std::uint32_t>(_entries.size());
+                    _entries.emplace_back(subscription_entry{ _npos, 1, priority, nullptr });
+                }
+
+                _entries[id].priority = priority;
+
+                // the subscriber is indexed first, so placing it is the last step that can fail
+                auto indexed = false;
+                decltype(_index.begin()) hashed;
+
+                try
+                {
+                    if (!_indexed && attached() + 1 >= _index_threshold)
+                        build_index();
+
+                    if (_indexed)
+                    {
+                        hashed = _index.emplace(invokable.hash(), id);
+                        indexed = true;
+                    }
+
+                    if (pending)
+                    {
+                        _pending.emplace_back(_TSlot{ invokable, id, true, owning, guard != nullptr });
+                        _entries[id].position = static_cast<std::uint32_t>(_pending.size() - 1) | _pending_bit;
+                    }
+                    else
+                    {
+                        place(_TSlot{ invokable, id, true, owning, guard != nullptr });
+                    }
+                }
+                catch (...)
+                {
+                    if (indexed)
+                        _index.erase(hashed);
+
+                    _entries[id].position = _free;
+                    _free = id;
+                    throw;
+                }
+
+                if (guard != nullptr)
+                {
+                    guard->retain();
+                    _entries[id].guard = guard;
+                    _guarded++;
+                }
+
+                return subscription_access::make(id, _entries[id].generation);
+            }
+
+            /**
+             * \brief Insert a slot after the last live slot of at least the same priority
+             *
+             * The slots are kept sorted, so dispatch stays a linear pass.
+             */
+            void place(const _TSlot& slot)
+            {
+                auto priority = _entries[slot.id].priority;
+                auto position = static_cast<std::uint32_t>(_invokables.size());
+
+                while (position > 0 && (!_invokables[position - 1].alive
+                    || _entries[_invokables[position - 1].id].priority < priority))
+                {
+                    position--;
+                }
+
+                _invokables.emplace_back(slot);
+                _entries[slot.id].position = position;
+
+                if (position + 1 != _invokables.size())
+                {
+                    std::rotate(_invokables.begin() + position, _invokables.end() - 1, _invokables.end());
+
+                    // a dead slot may share its id with a live subscriber that reused the entry
+                    for (auto i = position + 1; i < _invokables.size(); i++)
+                    {
+                        if (_invokables[i].alive)
+                            _entries[_invokables[i].id].position = i;
+                    }
+                }
+            }
+
+            /**
+             * \brief Visit placed and pending slots
+             */
+            template<typename TVisitor>
+            void for_each_slot(TVisitor visitor) const
+            {
+                std::for_each(_invokables.begin(), _invokables.end(), visitor);
+                std::for_each(_pending.begin(), _pending.end(), visitor);
+            }
+
+            _TSlot& slot_at(std::uint32_t position) noexcept
+            {
+                return (position & _pending_bit) != 0 ? _pending[position & ~_pending_bit] : _invokables[position];
+            }
+
+            void erase(std::uint32_t position)
+            {
+                unlink(slot_at(position));
+
+                if (!dispatch_frame::active(this))
+                    collect();
+            }
+
+            /**
+             * \brief Mark a slot as removed and retire its subscription
+             */
+            void unlink(_TSlot& slot) noexcept
+            {
+                auto& entry = _entries[slot.id];
+
+                if (_indexed)
+                {
+                    auto range = _index.equal_range(slot.invokable.hash());
+
+                    for (auto it = range.first; it != range.second; it++)
+                    {
+                        if (it->second == slot.id)
+                        {
+                            _index.erase(it);
+                            break;
+                        }
+                    }
+                }
+
+                if (entry.guard != nullptr)
+                {
+                    entry.guard->release();
+                    entry.guard = nullptr;
+                    _guarded--;
+                }
+
+                slot.alive = false;
+                entry.generation = entry.generation + 1 != 0 ? entry.generation + 1 : 1;
+                entry.position = _free;
+                _free = slot.id;
+                _dead++;
+
+                if (slot.owning && !dispatch_frame::active(this))
+                {
+                    slot.owning = false;
+                    slot.invokable.release();
+                }
+            }
+
+            /**
+             * \brief Detach subscribers whose tracked object has been destroyed
+             *
+             * Dispatch only skips them, and flags the event; the slots are only
+             * scanned by the next attach or detach after that, or when they are
+             * compacted anyway.
+             */
+            void drop_expired() noexcept
+            {
+                if (!_expired.load(std::memory_order_relaxed))
+                    return;
+
+                _expired.store(false, std::memory_order_relaxed);
+
+                if (unlink_expired() && !dispatch_frame::active(this))
+                    collect();
+            }
+
+            bool unlink_expired() noexcept
+            {
+                auto dropped = false;
+
+                for (auto& slot : _invokables)
+                {
+                    if (expired(slot))
+                    {
+                        unlink(slot);
+                        dropped = true;
+                    }
+                }
+
+                for (auto& slot : _pending)
+                {
+                    if (expired(slot))
+                    {
+                        unlink(slot);
+                        dropped = true;
+                    }
+                }
+
+                return dropped;
+            }
+
+            /**
+             * \brief Place pending slots and compact removed ones
+             *
+             * Runs when a dispatch returns, so it must not throw.
+             */
+            void collect() noexcept
+            {
+                if (!_pending.empty())
+                {
+                    merge();
+                }
+
+                if (2 * _dead > _invokables.size())
+                {
+                    compact();
+                }
+            }
+
+            /**
+             * \brief Place the subscribers attached during a dispatch
+             *
+             * The slots may only grow here, as slots being iterated never move.
+             * If growing them fails, the subscribers not yet placed stay
+             * pending, and are placed by the next collect.
+             */
+            void merge() noexcept
+            {
+                std::uint32_t merged = 0;
 
-        void remove(const _TInvokable& invokable)
+                try
+                {
+                    for (; merged < _pending.size(); merged++)
+                    {
+                        const auto& slot = _pending[merged];
+
+                        if (slot.alive)
+                        {
+                            place(slot);
+                            continue;
+                        }
+
+                        if (slot.owning)
+                            slot.invokable.release();
+
+                        _dead--;
+                    }
+                }
+                catch (...)
+                {
+                    // growing is all place can fail at, leaving the slots unchanged
+                }
+
+                for (auto i = merged; i < _pending.size(); i++)
+                {
+                    if (_pending[i].alive)
+                        _entries[_pending[i].id].position = (i - merged) | _pending_bit;
+
+                    _pending[i - merged] = _pending[i];
+                }
+
+                while (merged-- > 0)
+                {
+                    _pending.pop_back();
+                }
+            }
+
+            /**
+             * \brief Drop removed slots, keeping the order of the remaining ones
+             */
+            void compact() noexcept
+            {
+                std::uint32_t position = 0;
+
+                if (_guarded != 0)
+                    unlink_expired();
+
+                for (const auto& slot : _invokables)
+                {
+                    if (slot.alive)
+                    {
+                        _entries[slot.id].position = position;
+                        _invokables[position++] = slot;
+                    }
+                    else if (slot.owning)
+                    {
+                        slot.invokable.release();
+                    }
+                }
+
+                while (_invokables.size() > position)
+                {
+                    _invokables.pop_back();
+                }
+
+                // removed slots left pending by a failed merge are still counted
+                _dead = static_cast<std::size_t>(std::count_if(_pending.begin(), _pending.end(),
+                    [](const _TSlot& slot) { return !slot.alive; }));
+            }
+
+            /**
+             * \brief Drop the references to callables kept on the heap
+             */
+            void release() noexcept
+            {
+                for_each_slot([](const _TSlot& slot)
+                {
+                    if (slot.owning)
+                        slot.invokable.release();
+                });
+
+                for (auto& entry : _entries)
+                {
+                    if (entry.guard != nullptr)
+                        entry.guard->release();
+
+                    entry.guard = nullptr;
+                }
+
+                _invokables.clear();
+                _pending.clear();
+            }
+
+            void build_index()
+            {
+                try
+                {
+                    _index.reserve(2 * attached());
+
+                    for_each_slot([this](const _TSlot& slot)
+                    {
+                        if (slot.alive)
+                            _index.emplace(slot.invokable.hash(), slot.id);
+                    });
+                }
+                catch (...)
+                {
+                    _index.clear();
+                    throw;
+                }
+
+                _indexed = true;
+            }
+
+            bool remove(subscription handle)
+            {
+                drop_expired();
+
+                auto id = subscription_access::id(handle);
+
+                if (id >= _entries.size() || _entries[id].generation != subscription_access::generation(handle))
+                    return false;
+
+                erase(_entries[id].position);
+
+                return true;
+            }
+
+            void remove(const delegate_base& invokable)
+            {
+                drop_expired();
+
+                if (_indexed)
+                {
+                    auto range = _index.equal_range(invokable.hash());
+                    auto best = _npos;
+
+                    // detach the first matching subscriber in notification order, as the linear scan does;
+                    // pending positions sort after all placed ones
+                    for (auto it = range.first; it != range.second; it++)
+                    {
+                        auto position = _entries[it->second].position;
+
+                        if (slot_at(position).invokable == invokable && position < best)
+                            best = position;
+                    }
+
+                    if (best != _npos)
+                        erase(best);
+
+                    return;
+                }
+
+                for (std::uint32_t position = 0; position < _invokables.size(); position++)
+                {
+                    if (_invokables[position].alive && _invokables[position].invokable == invokable)
+                    {
+                        erase(position);
+                        return;
+                    }
+                }
+
+                for (std::uint32_t position = 0; position < _pending.size(); position++)
+                {
+                    if (_pending[position].alive && _pending[position].invokable == invokable)
+                    {
+                        erase(position | _pending_bit);
+                        return;
+                    }
+                }
+            }
+        };
+
+#ifdef EVENTCPP_COMPILED_CORE
+        extern template class event_core<0>;
+#endif
+
+        /**
+         * \brief Implementation shared by event and small_event
+         *
+         * \tparam TRet type returned by a callback of a subscriber
+         * \tparam Args arguments accepted by a callback of a subscriber
+         * \tparam N number of subscribers stored without heap allocation
+         * \tparam TInstrument instrumentation policy, no_instrumentation by default
+         */
+        template<typename TFunc, std::size_t N, bool TNoexcept = false, typename TInstrument = no_instrumentation>
+        class basic_event;
+
+        template<typename TRet, typename ...Args, std::size_t N, bool TNoexcept, typename TInstrument>
+        class basic_event<TRet(Args...), N, TNoexcept, TInstrument>
+            : public subscribable<basic_event<TRet(Args...), N, TNoexcept, TInstrument>, TRet(Args...), TNoexcept>,
+            public event_core<N>, public instrumented<TInstrument>
         {
-            auto it = _invokables.begin();
+            friend class subscribable<basic_event<TRet(Args...), N, TNoexcept, TInstrument>, TRet(Args...), TNoexcept>;
+
+            using _TCore = event_core<N>;
+            using _TDelegate = delegate<TRet(Args...)>;
+            using _TSlot = typename _TCore::_TSlot;
+            using _TItem = batch_item_t<Args...>;
+            using _TBatch = batch_adapter<Args...>;
+
+
+            /**
+             * \brief Marks the event as being dispatched on the calling thread
+             *
+             * Slots are addressed by index during a dispatch and removal only
+             * clears their alive flag, so subscribers may detach from the event
+             * they are notified by. Removed slots are compacted and slots
+             * attached meanwhile are placed once the outermost dispatch of the
+             * event returns.
+             */
+            class dispatch_scope
+            {
+            public:
+                explicit dispatch_scope(const basic_event& e) noexcept
+                    : _event(const_cast<basic_event&>(e)), _frame(static_cast<const _TCore*>(&e))
+                {
+                    if constexpr (TInstrument::enabled)
+                        e.instrument().on_dispatch(e.size());
+                }
+
+                ~dispatch_scope()
+                {
+                    if ((_event._dead != 0 || !_event._pending.empty()) && !_frame.nested())
+                        _event.collect();
+                }
+
+            private:
+                basic_event& _event;
+                dispatch_frame _frame;
+            };
+
+        public:
+            basic_event() = default;
 
-            while (it != _invokables.end() && (*(*it)) != invokable)
+            /**
+             * \brief Create event allocating its storage from a memory resource
+             */
+            explicit basic_event(std::pmr::memory_resource* resource) : _TCore(resource)
             {
-                it++;
             }
 
-            if (it != _invokables.end())
+            /**
+             * \brief Copy subscribers; the copy starts with fresh instrumentation
+             */
+            basic_event(const basic_event& other) : _TCore(other)
             {
-                _invokables.erase(it);
             }
-        }
+
+            basic_event(basic_event&& other) noexcept : _TCore(std::move(other))
+            {
+            }
+
+            basic_event& operator= (const basic_event& other)
+            {
+                _TCore::operator=(other);
+
+                return *this;
+            }
+
+            basic_event& operator= (basic_event&& other) noexcept
+            {
+                _TCore::operator=(std::move(other));
+
+                return *this;
+            }
+
+            using _TCore::size;
+            using _TCore::resource;
+
+            /**
+             * \brief The function call operator for notifying subscribers
+             *
+             * Arguments are taken once. Every subscriber but the last one
+             * receives its own copy of arguments passed by value, the last one
+             * receives them moved, and reference arguments are passed through,
+             * so no subscriber observes a moved-from object. Arguments taken by
+             * value must therefore be copy constructible; move-only types are
+             * taken as T&& or const T&.
+             *
+             * Subscribers may attach and detach subscribers, themselves included,
+             * while being notified. A detached subscriber that has not been
+             * notified yet is skipped; an attached one is first notified by the
+             * next notification.
+             *
+             * For events returning dispatch_result the notification stops at the
+             * first subscriber returning dispatch_result::stop.
+             *
+             * \param args arguments that will be passed to subscribed callbacks
+             * \return value returned by the last subscriber, a value-initialized
+             *         TRet if there is none
+             * \throw std::bad_function_call if there is no subscriber and TRet is
+             *        not default constructible
+             */
+            template<typename _TRet = TRet>
+            std::enable_if_t<!std::is_same<_TRet, void>::value, _TRet>
+                operator() (Args... args) const noexcept(TNoexcept)
+            {
+                if constexpr (std::is_same<_TRet, dispatch_result>::value)
+                    return dispatch<until_stop>(std::forward<Args>(args)...);
+
+                dispatch_scope scope(*this);
+
+                auto last = last_alive();
+
+                if (last == _npos)
+                    return empty_result<_TRet>();
+
+                for (std::size_t i = 0; i < last; i++)
+                {
+                    const auto& slot = _invokables[i];
+
+                    if (notifiable(slot))
+                    {
+                        [[maybe_unused]] auto timer = probe(slot);
+                        _TDelegate::call(slot.invokable, forward_copy<Args>(args)...);
+                    }
+                }
+
+                if (!notifiable(_invokables[last]))
+                    return empty_result<_TRet>();
+
+                [[maybe_unused]] auto timer = probe(_invokables[last]);
+                return _TDelegate::call(_invokables[last].invokable, std::forward<Args>(args)...);
+            }
+
+            template<typename _TRet = TRet>
+            std::enable_if_t<std::is_same<_TRet, void>::value, _TRet>
+                operator() (Args... args) const noexcept(TNoexcept)
+            {
+                dispatch_scope scope(*this);
+
+                auto last = last_alive();
+
+                if (last == _npos)
+                    return;
+
+                for (std::size_t i = 0; i < last; i++)
+                {
+                    const auto& slot = _invokables[i];
+
+                    if (notifiable(slot))
+                    {
+                        [[maybe_unused]] auto timer = probe(slot);
+                        _TDelegate::call(slot.invokable, forward_copy<Args>(args)...);
+                    }
+                }
+
+                if (notifiable(_invokables[last]))
+                {
+                    [[maybe_unused]] auto timer = probe(_invokables[last]);
+                    _TDelegate::call(_invokables[last].invokable, std::forward<Args>(args)...);
+                }
+            }
+
+            /**
+             * \brief Notify subscribers until the policy stops propagation
+             *
+             * After every subscriber TPolicy::proceed is called with its result;
+             * when it returns false the remaining subscribers are skipped.
+             *
+             * \tparam TPolicy policy such as until_false, until_true or until_stop
+             * \param args arguments that will be passed to subscribed callbacks
+             * \return result of the subscriber that stopped the notification, or
+             *         of the last subscriber
+             */
+            template<typename TPolicy>
+            TRet dispatch(Args... args) const noexcept(TNoexcept)
+            {
+                static_assert(!std::is_same<TRet, void>::value, "propagation of void subscribers cannot be stopped");
+
+                dispatch_scope scope(*this);
+
+                auto last = last_alive();
+
+                if (last == _npos)
+                    return empty_result<TRet>();
+
+                for (std::size_t i = 0; i < last; i++)
+                {
+                    const auto& slot = _invokables[i];
+
+                    if (notifiable(slot))
+                    {
+                        [[maybe_unused]] auto timer = probe(slot);
+                        TRet result = _TDelegate::call(slot.invokable, forward_copy<Args>(args)...);
+
+                        if (!TPolicy::proceed(result))
+                            return result;
+                    }
+                }
+
+                if (!notifiable(_invokables[last]))
+                    return empty_result<TRet>();
+
+                [[maybe_unused]] auto timer = probe(_invokables[last]);
+                return _TDelegate::call(_invokables[last].invokable, std::forward<Args>(args)...);
+            }
+
+            /**
+             * \brief Notify subscribers and combine their results
+             *
+             * The combiner is called with the result of every subscriber in
+             * turn; returning false from it stops the notification, and the
+             * remaining subscribers are not called.
+             *
+             * \param combiner object with bool operator() (TRet) and result()
+             * \param args arguments that will be passed to subscribed callbacks
+             * \return value returned by result() of the combiner
+             */
+            template<typename TCombiner>
+            auto invoke(TCombiner&& combiner, Args... args) const -> decltype(combiner.result())
+            {
+                static_assert(!std::is_same<TRet, void>::value, "results of void subscribers cannot be combined");
+
+                dispatch_scope scope(*this);
+
+                auto last = last_alive();
+
+                if (last != _npos)
+                {
+                    for (std::size_t i = 0; i < last; i++)
+                    {
+                        const auto& slot = _invokables[i];
+
+                        if (!notifiable(slot))
+                            continue;
+
+                        [[maybe_unused]] auto timer = probe(slot);
+
+                        if (!combiner(_TDelegate::call(slot.invokable, forward_copy<Args>(args)...)))
+                            return combiner.result();
+                    }
+
+                    if (notifiable(_invokables[last]))
+                    {
+                        [[maybe_unused]] auto timer = probe(_invokables[last]);
+                        combiner(_TDelegate::call(_invokables[last].invokable, std::forward<Args>(args)...));
+                    }
+                }
+
+                return combiner.result();
+            }
+
+            /**
+             * \brief Notify subscribers and combine their results
+             *
+             * \tparam TCombiner combiner template instantiated with TRet
+             */
+            template<template<typename> class TCombiner>
+            auto invoke(Args... args) const
+            {
+                return invoke(TCombiner<TRet>(), std::forward<Args>(args)...);
+            }
+
+            /**
+             * \brief Notify subscribers in chunks run in parallel on an executor
+             *
+             * The subscribers are split into chunks of consecutive subscribers;
+             * work items submitted to the executor and the calling thread run
+             * them concurrently, and the call returns once every chunk has
+             * completed. Subscribers within a chunk are called in order, chunks
+             * in no particular order. Arguments are shared by all subscribers
+             * through a const reference; arguments taken by value are copied
+             * for every subscriber.
+             *
+             * Subscribers must be safe to call concurrently and must not attach
+             * or detach subscribers of this event. Expired tracked subscribers
+             * are skipped and dropped by the next attach or detach, and an
+             * instrumentation policy sees the notification but not the calls.
+             *
+             * \param executor type with an execute member function accepting a callable
+             * \param args arguments that will be passed to subscribed callbacks
+             * \throw the first exception thrown by a subscriber, once all chunks completed
+             */
+            template<typename TExecutor>
+            void fire_parallel(TExecutor& executor, const std::remove_reference_t<Args>&... args) const
+            {
+                static_assert((... && shareable<Args>), "parallel notification shares arguments by const reference");
+
+                dispatch_scope scope(*this);
+
+                parallel(executor, [this, &args...](std::size_t begin, std::size_t end)
+                {
+                    for (auto i = begin; i < end; i++)
+                    {
+                        if (notifiable(_invokables[i]))
+                            _TDelegate::call(_invokables[i].invokable, static_cast<Args>(args)...);
+                    }
+                });
+            }
+
+            /**
+             * \brief Notify subscribers in parallel and combine their results in order
+             *
+             * Subscribers are notified as by fire_parallel. Their results are
+             * kept and passed to the combiner on the calling thread, in
+             * notification order, once all of them returned, so the combined
+             * result is the same as with invoke. Returning false from the
+             * combiner skips the remaining results.
+             *
+             * \param executor type with an execute member function accepting a callable
+             * \param combiner object with bool operator() (TRet) and result()
+             * \param args arguments that will be passed to subscribed callbacks
+             * \return value returned by result() of the combiner
+             */
+            template<typename TExecutor, typename TCombiner>
+            auto invoke_parallel(TExecutor& executor, TCombiner&& combiner,
+                const std::remove_reference_t<Args>&... args) const -> decltype(combiner.result())
+            {
+                static_assert(!std::is_same<TRet, void>::value, "results of void subscribers cannot be combined");
+                static_assert(!std::is_reference<TRet>::value, "results combined in parallel must not be references");
+                static_assert((... && shareable<Args>), "parallel notification shares arguments by const reference");
+
+                dispatch_scope scope(*this);
+
+                std::pmr::vector<std::optional<TRet>> results(_invokables.size(), resource());
+
+                parallel(executor, [this, &results, &args...](std::size_t begin, std::size_t end)
+                {
+                    for (auto i = begin; i < end; i++)
+                    {
+                        if (notifiable(_invokables[i]))
+                            results[i].emplace(_TDelegate::call(_invokables[i].invokable, static_cast<Args>(args)...));
+                    }
+                });
+
+                for (auto& result : results)
+                {
+                    if (result && !combiner(std::move(*result)))
+                        break;
+                }
+
+                return combiner.result();
+            }
+
+#ifdef EVENTCPP_COROUTINES
+            /**
+             * \brief Awaitable resumed with the arguments of the next notification
+             *
+             * co_await e.next() suspends the coroutine until the event is next
+             * notified and returns a tuple of the arguments. The coroutine is
+             * resumed on the notifying thread, inside the notification.
+             * Available for events returning void; the event must outlive the
+             * awaiting coroutine.
+             */
+            auto next()
+            {
+                static_assert(std::is_same<TRet, void>::value, "only events returning void can be awaited");
+
+                return next_awaiter<basic_event, TNoexcept, Args...>(*this);
+            }
+
+            /**
+             * \brief Subscriber awaited for successive notifications
+             *
+             * Unlike repeated next(), a stream does not miss notifications made
+             * while the awaiting coroutine runs; they are queued, allocating
+             * from the memory resource of the event, until awaited.
+             */
+            auto stream()
+            {
+                static_assert(std::is_same<TRet, void>::value, "only events returning void can be awaited");
+
+                return event_stream<basic_event, TNoexcept, Args...>(*this);
+            }
+#endif
+
+            /**
+             * \brief Notify subscribers once for each payload of a batch
+             *
+             * The loops are interchanged: each subscriber is called for every
+             * payload in a tight inner loop before the next subscriber is
+             * called, and batch subscribers receive the whole batch at once.
+             * Available for events taking a single argument by value or by
+             * const reference and returning void.
+             *
+             * \param items payloads that will be passed to subscribed callbacks
+             */
+            void notify_batch(span<const _TItem> items) const noexcept(TNoexcept)
+            {
+                static_assert(sizeof...(Args) == 1 && std::is_same<TRet, void>::value,
+                    "batch notification requires an event taking a single argument and returning void");
+
+                dispatch_scope scope(*this);
+
+                for (std::size_t i = 0, count = _invokables.size(); i < count; i++)
+                {
+                    if (!notifiable(_invokables[i]))
+                        continue;
+
+                    auto invokable = _invokables[i].invokable;
+                    [[maybe_unused]] auto timer = probe(_invokables[i]);
+
+                    if (_TBatch::is_batch(invokable))
+                    {
+                        _TBatch::call(invokable, items);
+                        continue;
+                    }
+
+                    for (const auto& item : items)
+                    {
+                        _TDelegate::call(invokable, static_cast<Args>(item)...);
+
+                        if (!_invokables[i].alive)
+                            break;
+                    }
+                }
+            }
+
+            /**
+             * \brief Attach callback accepting a whole batch of payloads
+             */
+            subscription attach_batch(void (*func) (span<const _TItem>) noexcept(TNoexcept), int priority = 0)
+            {
+                return insert(_TBatch::from_function(func), priority);
+            }
+
+            /**
+             * \brief Attach callback accepting a whole batch of payloads bound at compile time
+             */
+            template<auto TFunc>
+            subscription attach_batch(int priority = 0)
+            {
+                static_assert(is_invocable_v<TNoexcept, void, decltype(TFunc), span<const _TItem>>,
+                    "callback does not accept a batch");
+
+                return insert(_TBatch::template from_function<TFunc>(), priority);
+            }
+
+            /**
+             * \brief Attach member callback accepting a whole batch of payloads bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            subscription attach_batch(TClass& obj, int priority = 0)
+            {
+                static_assert(is_member_callable_v<TNoexcept, decltype(TFunc), TClass, void, span<const _TItem>>,
+                    "callback does not accept a batch");
+
+                return insert(_TBatch::template from_member<TFunc, TClass>(obj), priority);
+            }
+
+            /**
+             * \brief Attach member callback accepting a whole batch of payloads bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            subscription attach_batch(TClass* obj, int priority = 0)
+            {
+                return attach_batch<TFunc>(*obj, priority);
+            }
+
+            /**
+             * \brief Dettach callback accepting a whole batch of payloads
+             */
+            void detach_batch(void (*func) (span<const _TItem>) noexcept(TNoexcept))
+            {
+                remove(_TBatch::from_function(func));
+            }
+
+            /**
+             * \brief Dettach callback accepting a whole batch of payloads bound at compile time
+             */
+            template<auto TFunc>
+            void detach_batch()
+            {
+                remove(_TBatch::template from_function<TFunc>());
+            }
+
+            /**
+             * \brief Dettach member callback accepting a whole batch of payloads bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            void detach_batch(TClass& obj)
+            {
+                remove(_TBatch::template from_member<TFunc, TClass>(obj));
+            }
+
+            /**
+             * \brief Dettach member callback accepting a whole batch of payloads bound at compile time
+             */
+            template<auto TFunc, typename TClass>
+            void detach_batch(TClass* obj)
+            {
+                detach_batch<TFunc>(*obj);
+            }
+
+            /**
+             * \brief Seal the attached subscribers into an immutable frozen_event
+             *
+             * The frozen event keeps the subscribers attached now, in priority
+             * order, and is not affected by later changes to this event.
+             * Within a priority subscribers are grouped by thunk instead of
+             * being kept in attach order, so calls through the same thunk are
+             * adjacent, and a free function or a callable not bound to an
+             * object that is attached more than once is notified once.
+             * Callables kept on the heap and guards of tracked subscribers are
+             * shared with the event.
+             */
+            auto freeze() const
+            {
+                using _TFrozen = frozen_event<std::conditional_t<TNoexcept, TRet(Args...) noexcept, TRet(Args...)>>;
+                using _TSealed = frozen_slot<delegate_base>;
+
+                std::pmr::vector<_TSealed> slots(resource());
+                slots.reserve(size());
+
+                for_each_slot([this, &slots](const _TSlot& slot)
+                {
+                    const auto& entry = _entries[slot.id];
+
+                    if (slot.alive && (!slot.guarded || !entry.guard->expired()))
+                        slots.push_back(_TSealed{ slot.invokable, slot.guarded ? entry.guard : nullptr, entry.priority, slot.owning });
+                });
+
+                // pending slots follow placed ones, so a stable sort restores notification order
+                std::stable_sort(slots.begin(), slots.end(), [](const _TSealed& lhs, const _TSealed& rhs)
+                {
+                    return lhs.priority > rhs.priority;
+                });
+
+                std::pmr::unordered_set<delegate_base, typename _TCore::delegate_hash> functions(resource());
+
+                slots.erase(std::remove_if(slots.begin(), slots.end(), [&functions](const _TSealed& slot)
+                {
+                    return slot.guard == nullptr && !slot.owning && slot.invokable.object() == nullptr
+                        && !functions.insert(slot.invokable).second;
+                }), slots.end());
+
+                std::stable_sort(slots.begin(), slots.end(), [](const _TSealed& lhs, const _TSealed& rhs)
+                {
+                    if (lhs.priority != rhs.priority)
+                        return lhs.priority > rhs.priority;
+
+                    return std::less<>()(lhs.invokable.erased_thunk(), rhs.invokable.erased_thunk());
+                });
+
+                return _TFrozen(span<const _TSealed>(slots.data(), slots.size()), resource());
+            }
+
+
+        private:
+            using _TCore::_npos;
+            using _TCore::_invokables;
+            using _TCore::_entries;
+            using _TCore::_pending;
+            using _TCore::_dead;
+            using _TCore::notifiable;
+            using _TCore::last_alive;
+            using _TCore::insert;
+            using _TCore::remove;
+            using _TCore::collect;
+            using _TCore::for_each_slot;
+
+
+            template<typename T>
+            static constexpr bool shareable = (!std::is_reference<T>::value && std::is_copy_constructible<T>::value)
+                || (std::is_lvalue_reference<T>::value && std::is_const<std::remove_reference_t<T>>::value);
+
+            /**
+             * \brief Number of subscribers run as one chunk of a parallel notification
+             */
+            static constexpr std::size_t _parallel_grain = 256;
+
+            /**
+             * \brief Run chunk(begin, end) over the slots, in parallel on an executor
+             */
+            template<typename TExecutor, typename TChunk>
+            void parallel(TExecutor& executor, const TChunk& chunk) const
+            {
+                auto count = _invokables.size();
+                auto chunks = (count + _parallel_grain - 1) / _parallel_grain;
+
+                if (chunks <= 1)
+                {
+                    chunk(0, count);
+                    return;
+                }
+
+                auto run = [&chunk, count](std::size_t index)
+                {
+                    auto begin = index * _parallel_grain;
+                    chunk(begin, std::min(begin + _parallel_grain, count));
+                };
+
+                auto join = std::allocate_shared<parallel_join>(
+                    std::pmr::polymorphic_allocator<parallel_join>(resource()), chunks);
+
+                try
+                {
+                    for (std::size_t i = 1; i < chunks; i++)
+                    {
+                        executor.execute([join, &run] { join->run(run); });
+                    }
+                }
+                catch (...)
+                {
+                    // chunks not taken by a work item are run below
+                }
+
+                join->run(run);
+                join->wait();
+            }
+
+            /**
+             * \brief Start timing a call of the subscriber in a slot
+             */
+            auto probe(const _TSlot& slot) const noexcept
+            {
+                if constexpr (TInstrument::enabled)
+                    return call_probe<TInstrument>(this->instrument(),
+                        subscription_access::make(slot.id, _entries[slot.id].generation));
+                else
+                    return call_probe<TInstrument>();
+            }
+
+        };
+    }
+
+    template<typename TFunc, typename TInstrument = no_instrumentation> class event;
+
+    /**
+     * \brief A container class for subscribers to be notified
+     *
+     * \tparam TRet type returned by a callback of a subscriber
+     * \tparam Args arguments accepted by a callback of a subscriber
+     * \tparam TInstrument instrumentation policy such as dispatch_stats,
+     *         no_instrumentation by default
+     */
+    template<typename TRet, typename ...Args, typename TInstrument>
+    class event<TRet(Args...), TInstrument> : public details::basic_event<TRet(Args...), 0, false, TInstrument>
+    {
+    public:
+        using details::basic_event<TRet(Args...), 0, false, TInstrument>::basic_event;
+    };
+
+    /**
+     * \brief An event accepting only subscribers that do not throw
+     *
+     * Notifying is noexcept, so no unwinding paths are generated for the
+     * dispatch loop.
+     *
+     * \tparam TRet type returned by a callback of a subscriber
+     * \tparam Args arguments accepted by a callback of a subscriber
+     * \tparam TInstrument instrumentation policy, no_instrumentation by default
+     */
+    template<typename TRet, typename ...Args, typename TInstrument>
+    class event<TRet(Args...) noexcept, TInstrument> : public details::basic_event<TRet(Args...), 0, true, TInstrument>
+    {
+    public:
+        using details::basic_event<TRet(Args...), 0, true, TInstrument>::basic_event;
+    };
+
+    template<typename TFunc, std::size_t N, typename TInstrument = no_instrumentation> class small_event;
+
+    /**
+     * \brief An event storing up to N subscribers inside the object
+     *
+     * Subscribers beyond N spill to the heap, so events with a handful of
+     * subscribers can be embedded and subscribed to without allocating.
+     *
+     * \tparam TRet type returned by a callback of a subscriber
+     * \tparam Args arguments accepted by a callback of a subscriber
+     * \tparam N number of subscribers stored without heap allocation
+     * \tparam TInstrument instrumentation policy, no_instrumentation by default
+     */
+    template<typename TRet, typename ...Args, std::size_t N, typename TInstrument>
+    class small_event<TRet(Args...), N, TInstrument> : public details::basic_event<TRet(Args...), N, false, TInstrument>
+    {
+    public:
+        using details::basic_event<TRet(Args...), N, false, TInstrument>::basic_event;
+    };
+
+    /**
+     * \brief A small_event accepting only subscribers that do not throw
+     */
+    template<typename TRet, typename ...Args, std::size_t N, typename TInstrument>
+    class small_event<TRet(Args...) noexcept, N, TInstrument>
+        : public details::basic_event<TRet(Args...), N, true, TInstrument>
+    {
+    public:
+        using details::basic_event<TRet(Args...), N, true, TInstrument>::basic_event;
+    };
+
+    /**
+     * \brief An immutable event created by freeze of an event
+     *
+     * Subscribers are sealed into a read-only array and notified like
+     * subscribers of the event they were frozen from. Nothing can be attached
+     * or detached, so the event may be notified concurrently from any number
+     * of threads without locking; the subscribers themselves must be safe to
+     * call that way.
+     *
+     * \tparam TRet type returned by a callback of a subscriber
+     * \tparam Args arguments accepted by a callback of a subscriber
+     */
+    template<typename TRet, typename ...Args>
+    class frozen_event<TRet(Args...)> : public details::basic_frozen_event<TRet(Args...), false>
+    {
+    public:
+        using details::basic_frozen_event<TRet(Args...), false>::basic_frozen_event;
+    };
+
+    /**
+     * \brief A frozen_event of subscribers that do not throw
+     */
+    template<typename TRet, typename ...Args>
+    class frozen_event<TRet(Args...) noexcept> : public details::basic_frozen_event<TRet(Args...), true>
+    {
+    public:
+        using details::basic_frozen_event<TRet(Args...), true>::basic_frozen_event;
     };
 }
 
@@ -0,0 +1,128 @@
+/**
+ * \brief	Event bus routing messages to a channel per message type
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __event_bus__
+#define __event_bus__
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "event.hpp"
+
+namespace event
+{
+    namespace details
+    {
+        template<typename ...Ts>
+        struct distinct_types : std::true_type
+        {
+        };
+
+        template<typename T, typename ...Ts>
+        struct distinct_types<T, Ts...>
+            : std::bool_constant<!(std::is_same<T, Ts>::value || ...) && distinct_types<Ts...>::value>
+        {
+        };
+    }
+
+    /**
+     * \brief A set of events, one channel per message type
+     *
+     * Channels are event<void (const T&)> members of a tuple and a message
+     * is routed to its channel by type at compile time, so publishing costs
+     * exactly as much as notifying the channel: there is no lookup, no type
+     * id and no cast. Messages are routed by their exact type; publishing a
+     * type the bus was not declared with does not compile.
+     *
+     * \tparam TMessages distinct message types carried by the bus
+     */
+    template<typename ...TMessages>
+    class event_bus
+    {
+        static_assert(details::distinct_types<TMessages...>::value, "message types of a bus must be distinct");
+        static_assert((std::is_same<TMessages, std::decay_t<TMessages>>::value && ...),
+            "message types must not be references or cv-qualified");
+
+    public:
+        /**
+         * \brief Channel type carrying messages of type T
+         */
+        template<typename T>
+        using channel_type = event<void (const T&)>;
+
+        /**
+         * \brief Check whether the bus has a channel for messages of type T
+         */
+        template<typename T>
+        static constexpr bool carries = (std::is_same<T, TMessages>::value || ...);
+
+        /**
+         * \brief Channel carrying messages of type T
+         *
+         * Gives access to every attach and detach overload of event, the
+         * compile-time bound ones included.
+         */
+        template<typename T>
+        channel_type<T>& channel() noexcept
+        {
+            static_assert(carries<T>, "message type is not carried by the bus");
+
+            return std::get<channel_type<T>>(_channels);
+        }
+
+        template<typename T>
+        const channel_type<T>& channel() const noexcept
+        {
+            static_assert(carries<T>, "message type is not carried by the bus");
+
+            return std::get<channel_type<T>>(_channels);
+        }
+
+        /**
+         * \brief Attach subscriber to the channel of messages of type T
+         *
+         * \param args arguments accepted by attach of the channel
+         */
+        template<typename T, typename ...TArgs>
+        subscription attach(TArgs&&... args)
+        {
+            return channel<T>().attach(std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * \brief Detach subscriber from the channel of messages of type T
+         *
+         * \param args arguments accepted by detach of the channel
+         */
+        template<typename T, typename ...TArgs>
+        decltype(auto) detach(TArgs&&... args)
+        {
+            return channel<T>().detach(std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * \brief Notify subscribers of the channel of the message type
+         */
+        template<typename T>
+        void publish(const T& message) const
+        {
+            channel<T>()(message);
+        }
+
+        /**
+         * \brief Check whether no channel has subscribers
+         */
+        bool empty() const noexcept
+        {
+            return (channel<TMessages>().empty() && ...);
+        }
+
+    private:
+        std::tuple<channel_type<TMessages>...> _channels;
+    };
+}
+
+#endif // !__event_bus__
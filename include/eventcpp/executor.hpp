@@ -0,0 +1,194 @@
+/**
+ * \brief	Executors running event notifications
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __event_executor__
+#define __event_executor__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace event
+{
+    /**
+     * \brief Executor running submitted work immediately on the calling thread
+     *
+     * An executor is any type with an execute member function accepting a
+     * callable taking no arguments.
+     */
+    class inline_executor
+    {
+    public:
+        template<typename TWork>
+        void execute(TWork&& work)
+        {
+            std::forward<TWork>(work)();
+        }
+    };
+
+    /**
+     * \brief Work-stealing thread pool
+     *
+     * Every worker owns a queue. Work submitted from a worker goes to its own
+     * queue and is taken newest first, work submitted from other threads is
+     * distributed round-robin, and idle workers steal the oldest work from
+     * the queues of others. Work must not throw.
+     */
+    class thread_pool
+    {
+        struct alignas(64) queue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> work;
+        };
+
+    public:
+        explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+            : _count(std::max<std::size_t>(threads, 1)), _queues(new queue[_count])
+        {
+            _threads.reserve(_count);
+
+            for (std::size_t idx = 0; idx < _count; idx++)
+            {
+                _threads.emplace_back(&thread_pool::run, this, idx);
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator= (const thread_pool&) = delete;
+
+        /**
+         * \brief Run remaining work and join the workers
+         */
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+
+            _wakeup.notify_all();
+
+            for (auto& thread : _threads)
+            {
+                thread.join();
+            }
+        }
+
+        /**
+         * \brief Pool shared by objects that are not given an executor
+         */
+        static thread_pool& shared()
+        {
+            static thread_pool pool;
+
+            return pool;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _count;
+        }
+
+        template<typename TWork>
+        void execute(TWork&& work)
+        {
+            auto idx = _current == this ? _current_idx : _next.fetch_add(1, std::memory_order_relaxed) % _count;
+
+            {
+                std::lock_guard<std::mutex> lock(_queues[idx].mutex);
+                _queues[idx].work.emplace_back(std::forward<TWork>(work));
+            }
+
+            _pending.fetch_add(1);
+
+            {
+                // pairs with the predicate check of a worker going to sleep
+                std::lock_guard<std::mutex> lock(_mutex);
+            }
+
+            _wakeup.notify_one();
+        }
+
+    private:
+        std::size_t _count;
+        std::unique_ptr<queue[]> _queues;
+        std::vector<std::thread> _threads;
+        std::atomic<std::size_t> _next{ 0 };
+        std::atomic<std::size_t> _pending{ 0 };
+        std::mutex _mutex;
+        std::condition_variable _wakeup;
+        bool _stop = false;
+
+        static inline thread_local const thread_pool* _current = nullptr;
+        static inline thread_local std::size_t _current_idx = 0;
+
+        void run(std::size_t idx)
+        {
+            _current = this;
+            _current_idx = idx;
+
+            for (;;)
+            {
+                std::function<void()> work;
+
+                if (pop(idx, work) || steal(idx, work))
+                {
+                    _pending.fetch_sub(1);
+                    work();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wakeup.wait(lock, [this] { return _stop || _pending.load() != 0; });
+
+                if (_stop && _pending.load() == 0)
+                    return;
+            }
+        }
+
+        bool pop(std::size_t idx, std::function<void()>& work)
+        {
+            std::lock_guard<std::mutex> lock(_queues[idx].mutex);
+
+            if (_queues[idx].work.empty())
+                return false;
+
+            work = std::move(_queues[idx].work.back());
+            _queues[idx].work.pop_back();
+
+            return true;
+        }
+
+        bool steal(std::size_t idx, std::function<void()>& work)
+        {
+            for (std::size_t i = 1; i < _count; i++)
+            {
+                auto& victim = _queues[(idx + i) % _count];
+                std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+
+                if (lock.owns_lock() && !victim.work.empty())
+                {
+                    work = std::move(victim.work.front());
+                    victim.work.pop_front();
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    };
+}
+
+#endif // !__event_executor__
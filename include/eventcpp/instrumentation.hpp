@@ -0,0 +1,166 @@
+/**
+ * \brief	Instrumentation policies measuring event dispatch
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __event_instrumentation__
+#define __event_instrumentation__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+
+#include "event.hpp"
+
+namespace event
+{
+    /**
+     * \brief Instrumentation policy counting notifications and timing subscribers
+     *
+     * Passed as the last template argument of event or small_event and read
+     * through instrumentation(). Every subscriber call is timed with TClock,
+     * which may be any clock with a static now() and an integral rep, such as
+     * one reading the time stamp counter.
+     *
+     * A const event may be notified from several threads at once, so the
+     * counters are relaxed atomics and the slowest call is recorded under a
+     * lock, taken only when a call is slower than every one before it. Each
+     * reading is exact on its own, but readings taken while the event is
+     * being notified need not be consistent with each other.
+     *
+     * \tparam TClock clock used to time subscriber calls
+     */
+    template<typename TClock = std::chrono::steady_clock>
+    class dispatch_stats
+    {
+    public:
+        static constexpr bool enabled = true;
+
+        using clock = TClock;
+        using duration = typename TClock::duration;
+
+        static_assert(std::is_integral<typename duration::rep>::value, "clock must count time in integral ticks");
+
+        dispatch_stats() = default;
+
+        /**
+         * \brief Copy the current readings
+         */
+        dispatch_stats(const dispatch_stats& other) noexcept
+            : _dispatches(other.dispatches()), _calls(other.calls()), _subscribers(other.subscribers()),
+            _total(other.total().count())
+        {
+            std::lock_guard<std::mutex> lock(other._mutex);
+
+            _slowest = other._slowest;
+            _slowest_time.store(other._slowest_time.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        dispatch_stats& operator= (const dispatch_stats&) = delete;
+
+        void on_dispatch(std::size_t subscribers) noexcept
+        {
+            _dispatches.fetch_add(1, std::memory_order_relaxed);
+            _subscribers.store(subscribers, std::memory_order_relaxed);
+        }
+
+        void on_call(subscription subscriber, duration elapsed) noexcept
+        {
+            _calls.fetch_add(1, std::memory_order_relaxed);
+            _total.fetch_add(elapsed.count(), std::memory_order_relaxed);
+
+            if (elapsed.count() < _slowest_time.load(std::memory_order_relaxed))
+                return;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (!_slowest.valid() || elapsed.count() > _slowest_time.load(std::memory_order_relaxed))
+            {
+                _slowest = subscriber;
+                _slowest_time.store(elapsed.count(), std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * \brief Number of notifications, batches included
+         */
+        std::uint64_t dispatches() const noexcept
+        {
+            return _dispatches.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Number of subscriber calls
+         */
+        std::uint64_t calls() const noexcept
+        {
+            return _calls.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Number of subscribers attached when the event was last notified
+         */
+        std::size_t subscribers() const noexcept
+        {
+            return _subscribers.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Time spent in all subscriber calls
+         */
+        duration total() const noexcept
+        {
+            return duration(_total.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * \brief Handle of the subscriber whose single call took the longest
+         */
+        subscription slowest() const noexcept
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            return _slowest;
+        }
+
+        /**
+         * \brief Duration of the longest single subscriber call
+         */
+        duration slowest_time() const noexcept
+        {
+            return duration(_slowest_time.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * \brief Clear the readings; the event must not be notified meanwhile
+         */
+        void reset() noexcept
+        {
+            _dispatches.store(0, std::memory_order_relaxed);
+            _calls.store(0, std::memory_order_relaxed);
+            _subscribers.store(0, std::memory_order_relaxed);
+            _total.store(0, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _slowest = subscription();
+            _slowest_time.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        using _TRep = typename duration::rep;
+
+        std::atomic<std::uint64_t> _dispatches{ 0 };
+        std::atomic<std::uint64_t> _calls{ 0 };
+        std::atomic<std::size_t> _subscribers{ 0 };
+        std::atomic<_TRep> _total{ 0 };
+        mutable std::mutex _mutex;
+        subscription _slowest;
+        std::atomic<_TRep> _slowest_time{ 0 };
+    };
+}
+
+#endif // !__event_instrumentation__
@@ -0,0 +1,206 @@
+/**
+ * \brief	Event notifying only subscribers attached to a key
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __event_keyed_event__
+#define __event_keyed_event__
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <unordered_map>
+#include <utility>
+
+#include "event.hpp"
+
+namespace event
+{
+    template<typename TKey, typename TFunc, typename THash = std::hash<TKey>> class keyed_event;
+
+    /**
+     * \brief An event whose subscribers are attached to a key
+     *
+     * Each key has its own channel, an event<void (Args...)>, so notifying a
+     * key costs one hash lookup and calls of its subscribers only, however
+     * many subscribers other keys have. Wildcard subscribers are notified for
+     * every key, after the subscribers of the key.
+     *
+     * A channel is created by the first attach to its key and dropped once
+     * its last subscriber is detached through the keyed_event. Subscribers
+     * may attach and detach, for any key, while being notified.
+     *
+     * \tparam TKey type of the keys, hashed with THash
+     * \tparam Args arguments accepted by a callback of a subscriber
+     */
+    template<typename TKey, typename ...Args, typename THash>
+    class keyed_event<TKey, void (Args...), THash>
+    {
+    public:
+        using channel_type = event<void (Args...)>;
+
+        keyed_event() = default;
+
+        /**
+         * \brief Create event allocating channels from a memory resource
+         */
+        explicit keyed_event(std::pmr::memory_resource* resource) : _channels(resource), _wildcard(resource)
+        {
+        }
+
+        /**
+         * \brief Notify subscribers of the key, then wildcard subscribers
+         *
+         * \param key key whose subscribers are notified
+         * \param args arguments that will be passed to subscribed callbacks
+         */
+        void operator() (const TKey& key, Args... args) const
+        {
+            details::dispatch_frame frame(this);
+
+            auto found = _channels.find(key);
+
+            if (found != _channels.end())
+                found->second(details::forward_copy<Args>(args)...);
+
+            _wildcard(std::forward<Args>(args)...);
+
+            if (_sweep && !frame.nested())
+                const_cast<keyed_event&>(*this).sweep();
+        }
+
+        /**
+         * \brief Attach subscriber to a key
+         *
+         * \param key key whose notifications the subscriber receives
+         * \param args arguments accepted by attach of event
+         * \return handle valid for detaching from the same key
+         */
+        template<typename ...TArgs>
+        subscription attach(const TKey& key, TArgs&&... args)
+        {
+            return channel(key).attach(std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * \brief Attach subscriber notified for every key
+         */
+        template<typename ...TArgs>
+        subscription attach_any(TArgs&&... args)
+        {
+            return _wildcard.attach(std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * \brief Detach subscriber from a key
+         *
+         * \param key key the subscriber was attached to
+         * \param args arguments accepted by detach of event
+         * \return whether a subscriber was detached
+         */
+        template<typename ...TArgs>
+        bool detach(const TKey& key, TArgs&&... args)
+        {
+            auto found = _channels.find(key);
+
+            if (found == _channels.end())
+                return false;
+
+            auto size = found->second.size();
+            found->second.detach(std::forward<TArgs>(args)...);
+
+            auto detached = found->second.size() != size;
+
+            if (found->second.empty())
+            {
+                if (details::dispatch_frame::active(this))
+                    _sweep = true;
+                else
+                    _channels.erase(found);
+            }
+
+            return detached;
+        }
+
+        /**
+         * \brief Detach wildcard subscriber
+         */
+        template<typename ...TArgs>
+        decltype(auto) detach_any(TArgs&&... args)
+        {
+            return _wildcard.detach(std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * \brief Channel of a key, created if the key has no subscribers
+         *
+         * Gives access to every attach overload of event, the compile-time
+         * bound ones included. A channel emptied through it is kept until the
+         * next detach from its key through the keyed_event.
+         */
+        channel_type& channel(const TKey& key)
+        {
+            auto found = _channels.find(key);
+
+            if (found == _channels.end())
+                found = _channels.try_emplace(key, _channels.get_allocator().resource()).first;
+
+            return found->second;
+        }
+
+        /**
+         * \brief Channel of wildcard subscribers
+         */
+        channel_type& wildcard() noexcept
+        {
+            return _wildcard;
+        }
+
+        /**
+         * \brief Number of subscribers attached to a key, wildcards excluded
+         */
+        std::size_t size(const TKey& key) const noexcept
+        {
+            auto found = _channels.find(key);
+
+            return found != _channels.end() ? found->second.size() : 0;
+        }
+
+        /**
+         * \brief Number of keys with a channel
+         */
+        std::size_t keys() const noexcept
+        {
+            return _channels.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return _channels.empty() && _wildcard.empty();
+        }
+
+    private:
+        std::pmr::unordered_map<TKey, channel_type, THash> _channels;
+        channel_type _wildcard;
+
+        /**
+         * \brief Channels emptied during a notification wait to be dropped
+         */
+        mutable bool _sweep = false;
+
+        void sweep()
+        {
+            _sweep = false;
+
+            for (auto i = _channels.begin(); i != _channels.end();)
+            {
+                if (i->second.empty())
+                    i = _channels.erase(i);
+                else
+                    ++i;
+            }
+        }
+    };
+}
+
+#endif // !__event_keyed_event__
@@ -0,0 +1,280 @@
+/**
+ * \brief	Event queuing notifications from many threads for a single consumer
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __queued_event__
+#define __queued_event__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "event.hpp"
+
+namespace event
+{
+    namespace details
+    {
+        /**
+         * \brief Bounded multi-producer single-consumer ring of argument tuples
+         *
+         * Every cell carries a sequence number telling whose turn it is: a
+         * producer claims the cell at position P once its sequence equals P,
+         * publishes it by storing P + 1, and the consumer frees it for the next
+         * lap by storing P + capacity. Producers contend on the enqueue
+         * position only, the consumer owns the dequeue position, and neither
+         * allocates after construction.
+         */
+        template<typename T>
+        class mpsc_ring
+        {
+            static constexpr std::size_t _cache_line = 64;
+
+            struct cell
+            {
+                std::atomic<std::size_t> sequence;
+                alignas(T) unsigned char storage[sizeof(T)];
+
+                T& value() noexcept
+                {
+                    return *std::launder(reinterpret_cast<T*>(storage));
+                }
+            };
+
+        public:
+            mpsc_ring(std::size_t capacity, std::pmr::memory_resource* resource)
+                : _resource(resource), _capacity(round_up(capacity)), _mask(_capacity - 1)
+            {
+                _cells = static_cast<cell*>(_resource->allocate(sizeof(cell) * _capacity, alignof(cell)));
+
+                for (std::size_t i = 0; i < _capacity; i++)
+                {
+                    new (&_cells[i]) cell;
+                    _cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            mpsc_ring(const mpsc_ring&) = delete;
+            mpsc_ring& operator= (const mpsc_ring&) = delete;
+
+            ~mpsc_ring()
+            {
+                while (auto value = front())
+                {
+                    value->~T();
+                    pop();
+                }
+
+                for (std::size_t i = 0; i < _capacity; i++)
+                {
+                    _cells[i].~cell();
+                }
+
+                _resource->deallocate(_cells, sizeof(cell) * _capacity, alignof(cell));
+            }
+
+            std::size_t capacity() const noexcept
+            {
+                return _capacity;
+            }
+
+            /**
+             * \brief Move value into the ring, safe to call from any thread
+             *
+             * \return false if the ring is full
+             */
+            bool push(T&& value) noexcept
+            {
+                auto position = _enqueue.load(std::memory_order_relaxed);
+                cell* target;
+
+                for (;;)
+                {
+                    target = &_cells[position & _mask];
+
+                    auto sequence = target->sequence.load(std::memory_order_acquire);
+                    auto lap = static_cast<std::intptr_t>(sequence - position);
+
+                    if (lap == 0)
+                    {
+                        if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (lap < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = _enqueue.load(std::memory_order_relaxed);
+                    }
+                }
+
+                new (target->storage) T(std::move(value));
+                target->sequence.store(position + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * \brief Oldest published value, nullptr if there is none; consumer only
+             */
+            T* front() noexcept
+            {
+                auto& target = _cells[_dequeue & _mask];
+
+                if (target.sequence.load(std::memory_order_acquire) != _dequeue + 1)
+                    return nullptr;
+
+                return &target.value();
+            }
+
+            /**
+             * \brief Hand the cell of the destroyed front value back to producers; consumer only
+             */
+            void pop() noexcept
+            {
+                _cells[_dequeue & _mask].sequence.store(_dequeue + _capacity, std::memory_order_release);
+                _dequeue++;
+            }
+
+        private:
+            std::pmr::memory_resource* _resource;
+            std::size_t _capacity;
+            std::size_t _mask;
+            cell* _cells;
+
+            alignas(_cache_line) std::atomic<std::size_t> _enqueue{ 0 };
+            alignas(_cache_line) std::size_t _dequeue = 0;
+
+            static std::size_t round_up(std::size_t capacity) noexcept
+            {
+                std::size_t result = 1;
+
+                while (result < capacity)
+                {
+                    result <<= 1;
+                }
+
+                return result;
+            }
+        };
+    }
+
+    template<typename TFunc> class queued_event;
+
+    /**
+     * \brief An event queuing notifications from any thread for one consumer
+     *
+     * enqueue copies the arguments into a bounded lock-free ring and returns
+     * without allocating or locking; drain, called by a single consumer
+     * thread, notifies subscribers with the queued arguments in the order
+     * they were enqueued. Subscribers are attached and notified by the
+     * consumer like with event, which is also where they may be notified
+     * synchronously with operator().
+     *
+     * \tparam Args arguments accepted by a callback of a subscriber
+     */
+    template<typename ...Args>
+    class queued_event<void(Args...)> : public event<void(Args...)>
+    {
+        using _TArgs = std::tuple<std::decay_t<Args>...>;
+
+        static_assert(std::is_nothrow_move_constructible<_TArgs>::value,
+            "queued arguments must be nothrow move constructible");
+
+    public:
+        /**
+         * \brief Create event queuing up to capacity notifications
+         *
+         * \param capacity maximum number of queued notifications, rounded up
+         *        to a power of two
+         * \param resource memory resource of the ring and of the subscribers
+         */
+        explicit queued_event(std::size_t capacity,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : event<void(Args...)>(resource), _ring(capacity, resource)
+        {
+        }
+
+        /**
+         * \brief Queue a notification, safe to call from any thread
+         *
+         * \param args arguments that will be passed to subscribed callbacks
+         * \return false if the queue is full and the notification was dropped
+         */
+        bool enqueue(Args... args)
+        {
+            return _ring.push(_TArgs(std::forward<Args>(args)...));
+        }
+
+        /**
+         * \brief Notify subscribers with queued arguments; consumer thread only
+         *
+         * \param max maximum number of notifications to deliver
+         * \return number of notifications delivered
+         */
+        std::size_t drain(std::size_t max = std::numeric_limits<std::size_t>::max())
+        {
+            std::size_t count = 0;
+
+            for (; count < max; count++)
+            {
+                auto args = _ring.front();
+
+                if (args == nullptr)
+                    break;
+
+                consume_scope scope(_ring, *args);
+
+                std::apply([this](auto&... values)
+                {
+                    (*this)(static_cast<Args&&>(values)...);
+                }, *args);
+            }
+
+            return count;
+        }
+
+        /**
+         * \brief Maximum number of queued notifications
+         */
+        std::size_t capacity() const noexcept
+        {
+            return _ring.capacity();
+        }
+
+    private:
+        /**
+         * \brief Frees a queued notification once delivered, even if a subscriber throws
+         */
+        class consume_scope
+        {
+        public:
+            consume_scope(details::mpsc_ring<_TArgs>& ring, _TArgs& args) noexcept : _ring(ring), _args(args)
+            {
+            }
+
+            ~consume_scope()
+            {
+                _args.~_TArgs();
+                _ring.pop();
+            }
+
+        private:
+            details::mpsc_ring<_TArgs>& _ring;
+            _TArgs& _args;
+        };
+
+        details::mpsc_ring<_TArgs> _ring;
+    };
+}
+
+#endif // !__queued_event__
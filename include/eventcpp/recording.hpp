@@ -0,0 +1,507 @@
+/**
+ * \brief	Recording notifications of an event into a log and replaying them
+ * \author	Lukasz Wysocki
+ */
+
+#ifndef __event_recording__
+#define __event_recording__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "event.hpp"
+
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EVENTCPP_MAPPED_FILES 1
+#endif
+
+namespace event
+{
+    namespace details
+    {
+        /**
+         * \brief Header at the start of a log, followed by fixed-size records
+         */
+        struct log_header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t record_size;
+            std::uint32_t arity;
+            std::uint64_t count;
+        };
+
+        static constexpr std::uint32_t log_magic = 0x43525645;
+        static constexpr std::uint32_t log_version = 1;
+
+        /**
+         * \brief Layout of a record: a timestamp in nanoseconds followed by the packed arguments
+         *
+         * Arguments are copied byte by byte without padding and read back
+         * with memcpy, so a log does not have to be aligned.
+         */
+        template<typename ...Args>
+        struct log_record
+        {
+            static_assert((... && std::is_trivially_copyable<std::decay_t<Args>>::value),
+                "recorded arguments must be trivially copyable");
+            static_assert((... && (!std::is_lvalue_reference<Args>::value
+                || std::is_const<std::remove_reference_t<Args>>::value)),
+                "recorded arguments must not be taken by non-const reference");
+
+            static constexpr std::size_t size = sizeof(std::int64_t) + (std::size_t(0) + ... + sizeof(std::decay_t<Args>));
+
+            template<std::size_t I>
+            static constexpr std::size_t offset() noexcept
+            {
+                constexpr std::size_t sizes[] = { sizeof(std::decay_t<Args>)..., 0 };
+
+                std::size_t result = sizeof(std::int64_t);
+
+                for (std::size_t i = 0; i < I; i++)
+                {
+                    result += sizes[i];
+                }
+
+                return result;
+            }
+
+            static void store(std::byte* record, std::int64_t timestamp, const std::decay_t<Args>&... args) noexcept
+            {
+                std::memcpy(record, &timestamp, sizeof(timestamp));
+
+                auto position = record + sizeof(timestamp);
+
+                ((std::memcpy(position, std::addressof(args), sizeof(args)), position += sizeof(args)), ...);
+            }
+
+            static std::int64_t timestamp(const std::byte* record) noexcept
+            {
+                std::int64_t result;
+                std::memcpy(&result, record, sizeof(result));
+
+                return result;
+            }
+
+            template<typename T>
+            static T load(const std::byte* position) noexcept
+            {
+                std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+                std::memcpy(&storage, position, sizeof(T));
+
+                return *std::launder(reinterpret_cast<T*>(&storage));
+            }
+
+            template<typename TEvent, std::size_t ...I>
+            static void notify(const TEvent& e, const std::byte* record, std::index_sequence<I...>)
+            {
+                e(load<std::decay_t<Args>>(record + offset<I>())...);
+            }
+        };
+    }
+
+    template<typename TFunc, typename TClock = std::chrono::steady_clock> class recorder;
+
+    /**
+     * \brief Subscriber appending every notification of an event to a log
+     *
+     * Each notification takes one fixed-size record holding the time it was
+     * made and a byte copy of its arguments; nothing is serialized and
+     * nothing is allocated. The log is any writable memory, such as a
+     * mapped_file, and starts with a header whose record count is updated
+     * after each record, so a log cut short holds every complete record.
+     * Notifications that no longer fit are counted as dropped.
+     *
+     * A recorder is a subscriber like any other and is notified on the
+     * thread notifying the event; it must not be notified concurrently.
+     *
+     * \tparam Args trivially copyable arguments of the recorded event
+     * \tparam TClock clock timestamping the records
+     */
+    template<typename ...Args, typename TClock>
+    class recorder<void(Args...), TClock>
+    {
+        using _TRecord = details::log_record<Args...>;
+
+    public:
+        /**
+         * \brief Start a log in a buffer, overwriting its content
+         *
+         * \throw std::length_error if the buffer cannot hold the header
+         */
+        explicit recorder(span<std::byte> log) : _log(log)
+        {
+            if (_log.size() < sizeof(details::log_header))
+                throw std::length_error("log buffer is smaller than its header");
+
+            _capacity = (_log.size() - sizeof(details::log_header)) / _TRecord::size;
+
+            details::log_header header{ details::log_magic, details::log_version,
+                static_cast<std::uint32_t>(_TRecord::size), static_cast<std::uint32_t>(sizeof...(Args)), 0 };
+
+            std::memcpy(_log.data(), &header, sizeof(header));
+        }
+
+        recorder(const recorder&) = delete;
+        recorder& operator= (const recorder&) = delete;
+
+        /**
+         * \brief Attach the recorder to an event
+         *
+         * Attached with the highest priority by default, so records are
+         * timestamped before other subscribers run.
+         *
+         * \return handle for detaching the recorder
+         */
+        template<typename TEvent>
+        subscription attach_to(TEvent& e, int priority = std::numeric_limits<int>::max())
+        {
+            return e.template attach<&recorder::record>(*this, priority);
+        }
+
+        /**
+         * \brief Append a notification to the log
+         */
+        void record(Args... args) noexcept
+        {
+            if (_count == _capacity)
+            {
+                _dropped++;
+                return;
+            }
+
+            auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                TClock::now().time_since_epoch()).count();
+
+            _TRecord::store(_log.data() + sizeof(details::log_header) + _count * _TRecord::size,
+                static_cast<std::int64_t>(timestamp), args...);
+
+            _count++;
+
+            std::uint64_t count = _count;
+            std::memcpy(_log.data() + offsetof(details::log_header, count), &count, sizeof(count));
+        }
+
+        /**
+         * \brief Number of recorded notifications
+         */
+        std::size_t size() const noexcept
+        {
+            return _count;
+        }
+
+        /**
+         * \brief Number of notifications the log can hold
+         */
+        std::size_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        /**
+         * \brief Number of notifications not recorded because the log was full
+         */
+        std::size_t dropped() const noexcept
+        {
+            return _dropped;
+        }
+
+        /**
+         * \brief Bytes of the log in use, header included
+         */
+        span<const std::byte> data() const noexcept
+        {
+            return span<const std::byte>(_log.data(), sizeof(details::log_header) + _count * _TRecord::size);
+        }
+
+    private:
+        span<std::byte> _log;
+        std::size_t _capacity;
+        std::size_t _count = 0;
+        std::size_t _dropped = 0;
+    };
+
+    template<typename TFunc> class replayer;
+
+    /**
+     * \brief Notifies an event with the notifications recorded in a log
+     *
+     * A log can be replayed any number of times, into the event it was
+     * recorded from or any event or frozen_event taking the same arguments,
+     * either at full speed or paced by the recorded timestamps.
+     *
+     * \tparam Args arguments of the recorded event
+     */
+    template<typename ...Args>
+    class replayer<void(Args...)>
+    {
+        using _TRecord = details::log_record<Args...>;
+
+    public:
+        /**
+         * \brief Read a log written by a recorder of the same signature
+         *
+         * \throw std::invalid_argument if the log is not such a log
+         */
+        explicit replayer(span<const std::byte> log) : _log(log)
+        {
+            details::log_header header;
+
+            if (_log.size() < sizeof(header))
+                throw std::invalid_argument("log is smaller than its header");
+
+            std::memcpy(&header, _log.data(), sizeof(header));
+
+            if (header.magic != details::log_magic || header.version != details::log_version)
+                throw std::invalid_argument("buffer does not hold an event log");
+
+            if (header.record_size != _TRecord::size || header.arity != sizeof...(Args))
+                throw std::invalid_argument("log was recorded with a different signature");
+
+            if (header.count > (_log.size() - sizeof(header)) / _TRecord::size)
+                throw std::invalid_argument("log is truncated");
+
+            _count = static_cast<std::size_t>(header.count);
+        }
+
+        /**
+         * \brief Number of recorded notifications
+         */
+        std::size_t size() const noexcept
+        {
+            return _count;
+        }
+
+        bool empty() const noexcept
+        {
+            return _count == 0;
+        }
+
+        /**
+         * \brief Time between the first and the last recorded notification
+         */
+        std::chrono::nanoseconds duration() const noexcept
+        {
+            if (_count == 0)
+                return std::chrono::nanoseconds::zero();
+
+            return std::chrono::nanoseconds(_TRecord::timestamp(record(_count - 1)) - _TRecord::timestamp(record(0)));
+        }
+
+        /**
+         * \brief Notify an event with every recorded notification, as fast as possible
+         *
+         * \return number of notifications made
+         */
+        template<typename TEvent>
+        std::size_t replay(const TEvent& e) const
+        {
+            for (std::size_t i = 0; i < _count; i++)
+            {
+                _TRecord::notify(e, record(i), std::index_sequence_for<Args...>());
+            }
+
+            return _count;
+        }
+
+        /**
+         * \brief Notify an event with every recorded notification at the recorded pace
+         *
+         * Each notification is made once the time since the first one, as
+         * recorded and divided by speed, has elapsed; a notification running
+         * late is made right away and does not delay later ones.
+         *
+         * \param speed how many times faster than recorded to replay
+         * \return number of notifications made
+         */
+        template<typename TEvent>
+        std::size_t replay_paced(const TEvent& e, double speed = 1.0) const
+        {
+            if (_count == 0)
+                return 0;
+
+            auto start = std::chrono::steady_clock::now();
+            auto first = _TRecord::timestamp(record(0));
+
+            for (std::size_t i = 0; i < _count; i++)
+            {
+                auto offset = std::chrono::duration<double, std::nano>((_TRecord::timestamp(record(i)) - first) / speed);
+
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+
+                _TRecord::notify(e, record(i), std::index_sequence_for<Args...>());
+            }
+
+            return _count;
+        }
+
+    private:
+        span<const std::byte> _log;
+        std::size_t _count;
+
+        const std::byte* record(std::size_t i) const noexcept
+        {
+            return _log.data() + sizeof(details::log_header) + i * _TRecord::size;
+        }
+    };
+
+#ifdef EVENTCPP_MAPPED_FILES
+    /**
+     * \brief File mapped into memory, holding a log
+     *
+     * Records written into the mapping reach the file through the page cache
+     * without a system call per record.
+     */
+    class mapped_file
+    {
+    public:
+        /**
+         * \brief Create or truncate a file of a fixed size, mapped for writing
+         *
+         * \throw std::system_error if the file cannot be created or mapped
+         */
+        mapped_file(const char* path, std::size_t size) : _size(size), _writable(true)
+        {
+            _fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+            if (_fd < 0)
+                fail("cannot create log file");
+
+            if (::ftruncate(_fd, static_cast<off_t>(size)) != 0)
+                fail("cannot size log file");
+
+            map(PROT_READ | PROT_WRITE);
+        }
+
+        /**
+         * \brief Map an existing file for reading
+         *
+         * \throw std::system_error if the file cannot be opened or mapped
+         */
+        explicit mapped_file(const char* path) : _writable(false)
+        {
+            _fd = ::open(path, O_RDONLY);
+
+            if (_fd < 0)
+                fail("cannot open log file");
+
+            struct stat info;
+
+            if (::fstat(_fd, &info) != 0)
+                fail("cannot read size of log file");
+
+            _size = static_cast<std::size_t>(info.st_size);
+
+            map(PROT_READ);
+        }
+
+        mapped_file(mapped_file&& other) noexcept
+            : _fd(std::exchange(other._fd, -1)), _data(std::exchange(other._data, nullptr)),
+            _size(std::exchange(other._size, 0)), _writable(other._writable)
+        {
+        }
+
+        mapped_file& operator= (mapped_file&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+
+                _fd = std::exchange(other._fd, -1);
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+                _writable = other._writable;
+            }
+
+            return *this;
+        }
+
+        ~mapped_file()
+        {
+            close();
+        }
+
+        /**
+         * \brief Mapped bytes of the file
+         */
+        span<const std::byte> data() const noexcept
+        {
+            return span<const std::byte>(_data, _size);
+        }
+
+        /**
+         * \brief Mapped bytes of a file created for writing
+         *
+         * \throw std::logic_error if the file was mapped for reading only
+         */
+        span<std::byte> writable_data()
+        {
+            if (!_writable)
+                throw std::logic_error("log file is mapped for reading only");
+
+            return span<std::byte>(_data, _size);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _size;
+        }
+
+    private:
+        int _fd = -1;
+        std::byte* _data = nullptr;
+        std::size_t _size = 0;
+        bool _writable;
+
+        void map(int protection)
+        {
+            if (_size == 0)
+                return;
+
+            auto address = ::mmap(nullptr, _size, protection, MAP_SHARED, _fd, 0);
+
+            if (address == MAP_FAILED)
+                fail("cannot map log file");
+
+            _data = static_cast<std::byte*>(address);
+        }
+
+        [[noreturn]] void fail(const char* what)
+        {
+            auto error = errno;
+
+            close();
+
+            throw std::system_error(error, std::generic_category(), what);
+        }
+
+        void close() noexcept
+        {
+            if (_data != nullptr)
+                ::munmap(_data, _size);
+
+            if (_fd >= 0)
+                ::close(_fd);
+
+            _data = nullptr;
+            _fd = -1;
+        }
+    };
+#endif
+}
+
+#endif // !__event_recording__
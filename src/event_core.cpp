@@ -0,0 +1,14 @@
+/**
+ * \brief	Subscriber storage of event compiled once for all signatures
+ * \author	Lukasz Wysocki
+ */
+
+#include <eventcpp/event.hpp>
+
+namespace event
+{
+    namespace details
+    {
+        template class event_core<0>;
+    }
+}
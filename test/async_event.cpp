@@ -0,0 +1,133 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <eventcpp/async_event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class Recorder
+    {
+    public:
+        std::vector<int> values;
+        std::thread::id thread;
+
+        void Record(int val)
+        {
+            values.push_back(val);
+            thread = std::this_thread::get_id();
+        }
+    };
+
+    class Text
+    {
+    public:
+        std::string text;
+
+        void Append(const std::string& val)
+        {
+            text += val;
+        }
+    };
+}
+
+TEST_CASE("async_event should deliver posted notifications in order")
+{
+    event::thread_pool pool(4);
+    Recorder r1, r2;
+
+    {
+        event::async_event<void (int)> e(pool);
+        e.attach(&Recorder::Record, r1);
+        e.attach(&Recorder::Record, r2);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            e.post(i);
+        }
+
+        e.wait();
+        REQUIRE(r1.values.size() == 1000);
+    }
+
+    for (int i = 0; i < 1000; i++)
+    {
+        REQUIRE(r1.values[i] == i);
+        REQUIRE(r2.values[i] == i);
+    }
+
+    REQUIRE(r1.thread != std::this_thread::get_id());
+}
+
+TEST_CASE("async_event should copy posted arguments")
+{
+    event::inline_executor executor;
+    event::async_event<void (const std::string&), event::inline_executor> e(executor);
+    Text t;
+
+    e.attach(&Text::Append, t);
+
+    {
+        std::string val = "abc";
+        e.post(val);
+    }
+
+    e.post("def");
+    REQUIRE(t.text == "abcdef");
+}
+
+TEST_CASE("thread_pool should run work submitted from workers")
+{
+    std::atomic<int> count{ 0 };
+
+    {
+        event::thread_pool pool(3);
+
+        for (int i = 0; i < 100; i++)
+        {
+            pool.execute([&pool, &count]
+            {
+                pool.execute([&count] { count++; });
+                count++;
+            });
+        }
+    }
+
+    REQUIRE(count == 200);
+}
+
+TEST_CASE("async_event should keep delivering after a subscriber throws")
+{
+    event::inline_executor inline_exec;
+    event::thread_pool pool(2);
+
+    auto check = [](auto& executor)
+    {
+        Recorder r;
+        event::async_event<void (int), std::decay_t<decltype(executor)>> e(executor);
+
+        e.attach([](int val)
+        {
+            if (val == 1)
+                throw std::runtime_error("subscriber failed");
+        });
+        e.attach(&Recorder::Record, r);
+
+        e.post(1);
+        e.post(2);
+
+        REQUIRE_THROWS_AS(e.wait(), std::runtime_error);
+        REQUIRE(r.values == std::vector<int>{ 2 });
+
+        e.post(3);
+        REQUIRE_NOTHROW(e.wait());
+        REQUIRE(r.values == std::vector<int>{ 2, 3 });
+    };
+
+    check(inline_exec);
+    check(pool);
+}
@@ -0,0 +1,157 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/concurrent_event.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Counter
+    {
+        int value = 0;
+
+        void Add(int x)
+        {
+            value += x;
+        }
+    };
+}
+
+TEST_CASE("event should notify lambdas capturing pointers")
+{
+    event::event<int (int)> e;
+    int calls = 0;
+    int factor = 3;
+
+    auto lambda = [&calls, &factor](int x) { calls++; return x * factor; };
+    static_assert(event::details::delegate<int (int)>::stores_inline<decltype(lambda)>, "lambda should be stored inline");
+
+    e.attach(lambda);
+    e.attach([](int x) { return x + 1; });
+
+    REQUIRE(e(5) == 6);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("event should notify large and stateful callables")
+{
+    event::event<void (const std::string&)> e;
+    std::string log;
+    std::array<char, 64> prefix{ { '>' } };
+
+    e.attach([prefix, &log](const std::string& s) { log += prefix.data() + s; });
+    e.attach(std::function<void (const std::string&)>([&log](const std::string& s) { log += s; }));
+
+    int count = 0;
+    e.attach([&count, n = 0](const std::string&) mutable { count = ++n; });
+
+    e("a");
+    e("b");
+
+    REQUIRE(log == ">aa>bb");
+    REQUIRE(count == 2);
+}
+
+TEST_CASE("event should destroy heap callables once detached")
+{
+    auto state = std::make_shared<int>(0);
+    event::event<void (int)> e;
+
+    auto h = e.attach([state](int x) { *state += x; });
+    REQUIRE(state.use_count() == 2);
+
+    e(2);
+    REQUIRE(*state == 2);
+
+    REQUIRE(e.detach(h));
+    REQUIRE(state.use_count() == 1);
+
+    {
+        event::small_event<void (int), 2> scoped;
+        scoped.attach([state](int) {}, 1);
+        REQUIRE(state.use_count() == 2);
+    }
+
+    REQUIRE(state.use_count() == 1);
+}
+
+TEST_CASE("event copies should share heap callables")
+{
+    auto state = std::make_shared<int>(0);
+    event::event<void (int)> e;
+    e.attach([state](int x) { *state += x; });
+
+    {
+        auto copy = e;
+        auto moved = std::move(copy);
+        REQUIRE(state.use_count() == 2);
+
+        moved(1);
+        e(1);
+        REQUIRE(*state == 2);
+
+        e = moved;
+    }
+
+    REQUIRE(state.use_count() == 2);
+
+    e = event::event<void (int)>();
+    REQUIRE(state.use_count() == 1);
+}
+
+TEST_CASE("heap callables should outlive detaching themselves during dispatch")
+{
+    auto state = std::make_shared<int>(0);
+    event::event<void ()> e;
+    event::subscription self;
+
+    self = e.attach([state, &e, &self]() { e.detach(self); *state += 1; });
+    e();
+    e();
+
+    REQUIRE(*state == 1);
+    REQUIRE(state.use_count() == 1);
+}
+
+TEST_CASE("event should reject empty callables")
+{
+    event::event<void (int)> e;
+
+    REQUIRE_THROWS_AS(e.attach(std::function<void (int)>()), std::bad_function_call);
+    REQUIRE(e.empty());
+}
+
+TEST_CASE("event should call member functions of the first argument")
+{
+    event::event<void (Counter&, int)> e;
+    Counter c;
+
+    e.attach(&Counter::Add);
+    e(c, 4);
+
+    REQUIRE(c.value == 4);
+}
+
+TEST_CASE("concurrent_event should release heap callables")
+{
+    auto state = std::make_shared<int>(0);
+
+    {
+        event::concurrent_event<void (int)> e;
+        auto h = e.attach([state](int x) { *state += x; });
+        e.attach([state](int x) { *state += 10 * x; });
+
+        e(1);
+        REQUIRE(*state == 11);
+
+        REQUIRE(e.detach(h));
+        e.synchronize();
+        REQUIRE(state.use_count() == 2);
+    }
+
+    REQUIRE(state.use_count() == 1);
+}
@@ -0,0 +1,144 @@
+#include <eventcpp/coalescing_event.hpp>
+
+#include <chrono>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct manual_clock
+    {
+        using rep = std::int64_t;
+        using period = std::milli;
+        using duration = std::chrono::duration<rep, period>;
+        using time_point = std::chrono::time_point<manual_clock>;
+
+        static inline rep ticks = 0;
+
+        static time_point now() noexcept
+        {
+            return time_point(duration(ticks));
+        }
+    };
+
+    struct accumulate
+    {
+        void operator() (std::tuple<int>& pending, std::tuple<int>&& incoming) const
+        {
+            std::get<0>(pending) += std::get<0>(incoming);
+        }
+    };
+
+    class View
+    {
+    public:
+        std::vector<std::string> frames;
+
+        void Render(const std::string& state, int version)
+        {
+            frames.push_back(state + std::to_string(version));
+        }
+    };
+}
+
+TEST_CASE("coalescing_event should deliver the latest arguments once per flush")
+{
+    event::coalescing_event<void (const std::string&, int)> e;
+    View v;
+
+    e.attach(&View::Render, v);
+
+    REQUIRE_FALSE(e.flush());
+
+    for (int i = 0; i < 10000; i++)
+    {
+        REQUIRE_FALSE(e.post("state", i));
+    }
+
+    REQUIRE(e.pending());
+    REQUIRE(v.frames.empty());
+
+    REQUIRE(e.flush());
+    REQUIRE_FALSE(e.flush());
+    REQUIRE(v.frames == std::vector<std::string>{ "state9999" });
+    REQUIRE_FALSE(e.pending());
+
+    e("direct", 1);
+    REQUIRE(v.frames.size() == 2);
+}
+
+TEST_CASE("coalescing_event should merge arguments with a merge function")
+{
+    event::coalescing_event<void (int), accumulate> e;
+    std::vector<int> totals;
+
+    e.attach([&totals](int x) { totals.push_back(x); });
+
+    e.post(1);
+    e.post(2);
+    e.post(3);
+    e.flush();
+    e.post(4);
+    e.flush();
+
+    REQUIRE(totals == std::vector<int>{ 6, 4 });
+}
+
+TEST_CASE("coalescing_event should deliver at most once per interval")
+{
+    manual_clock::ticks = 0;
+
+    event::coalescing_event<void (int), event::keep_latest, manual_clock> e(std::chrono::milliseconds(100));
+    std::vector<int> values;
+
+    e.attach([&values](int x) { values.push_back(x); });
+
+    REQUIRE(e.post(1));
+    REQUIRE_FALSE(e.post(2));
+    REQUIRE_FALSE(e.post(3));
+    REQUIRE_FALSE(e.poll());
+
+    manual_clock::ticks = 99;
+    REQUIRE_FALSE(e.poll());
+
+    manual_clock::ticks = 100;
+    REQUIRE(e.poll());
+    REQUIRE(values == std::vector<int>{ 1, 3 });
+
+    manual_clock::ticks = 150;
+    REQUIRE_FALSE(e.post(4));
+    REQUIRE(e.flush());
+
+    manual_clock::ticks = 200;
+    REQUIRE_FALSE(e.post(5));
+
+    manual_clock::ticks = 250;
+    REQUIRE(e.post(6));
+    REQUIRE(values == std::vector<int>{ 1, 3, 4, 6 });
+    REQUIRE_FALSE(e.pending());
+}
+
+TEST_CASE("coalescing_event subscribers may post while being delivered")
+{
+    event::coalescing_event<void (int)> e;
+    std::vector<int> values;
+
+    e.attach([&](int x)
+    {
+        values.push_back(x);
+
+        if (x < 3)
+            e.post(x + 1);
+    });
+
+    e.post(1);
+
+    while (e.flush())
+    {
+    }
+
+    REQUIRE(values == std::vector<int>{ 1, 2, 3 });
+}
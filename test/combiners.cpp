@@ -0,0 +1,126 @@
+#include <iterator>
+#include <vector>
+
+#include <eventcpp/combiners.hpp>
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class Voter
+    {
+    public:
+        int value;
+        int calls = 0;
+
+        Voter(int v) : value(v) {}
+
+        int Vote(int offset)
+        {
+            calls++;
+            return value + offset;
+        }
+
+        bool Accept(int limit)
+        {
+            calls++;
+            return value < limit;
+        }
+    };
+
+    class Heavy
+    {
+    public:
+        explicit Heavy(int v) : value(v) {}
+
+        int value;
+    };
+
+    Heavy MakeHeavy(int v)
+    {
+        return Heavy(v);
+    }
+}
+
+TEST_CASE("event should combine results of subscribers")
+{
+    event::event<int (int)> e;
+    Voter v1(3), v2(1), v3(2);
+
+    e.attach(&Voter::Vote, v1);
+    e.attach(&Voter::Vote, v2);
+    e.attach(&Voter::Vote, v3);
+
+    SECTION("first stops after the first subscriber")
+    {
+        REQUIRE(*e.invoke<event::combiners::first>(10) == 13);
+        REQUIRE(v2.calls == 0);
+    }
+    SECTION("last")
+    {
+        REQUIRE(*e.invoke<event::combiners::last>(10) == 12);
+        REQUIRE(e(10) == 12);
+    }
+    SECTION("sum")
+    {
+        REQUIRE(e.invoke<event::combiners::sum>(0) == 6);
+        REQUIRE(e.invoke(event::combiners::sum<int>(100), 0) == 106);
+    }
+    SECTION("minimum and maximum")
+    {
+        REQUIRE(*e.invoke<event::combiners::minimum>(0) == 1);
+        REQUIRE(*e.invoke<event::combiners::maximum>(0) == 3);
+    }
+    SECTION("collect")
+    {
+        std::vector<int> results;
+        e.invoke(event::combiners::collect(std::back_inserter(results)), 1);
+
+        REQUIRE(results == std::vector<int>{ 4, 2, 3 });
+    }
+    SECTION("no subscribers")
+    {
+        event::event<int (int)> none;
+
+        REQUIRE_FALSE(none.invoke<event::combiners::last>(1).has_value());
+        REQUIRE(none(1) == 0);
+    }
+}
+
+TEST_CASE("event should stop combining results early")
+{
+    event::event<bool (int)> e;
+    Voter v1(1), v2(5), v3(2);
+
+    e.attach(&Voter::Accept, v1);
+    e.attach(&Voter::Accept, v2);
+    e.attach(&Voter::Accept, v3);
+
+    SECTION("all_of stops at the first rejection")
+    {
+        REQUIRE_FALSE(e.invoke<event::combiners::all_of>(4));
+        REQUIRE(v3.calls == 0);
+    }
+    SECTION("any_of stops at the first acceptance")
+    {
+        REQUIRE(e.invoke<event::combiners::any_of>(4));
+        REQUIRE(v2.calls == 0);
+    }
+    SECTION("all_of without rejection")
+    {
+        REQUIRE(e.invoke<event::combiners::all_of>(10));
+        REQUIRE(v3.calls == 1);
+    }
+}
+
+TEST_CASE("event should return results that are not default constructible")
+{
+    event::event<Heavy (int)> e;
+
+    REQUIRE_THROWS_AS(e(1), std::bad_function_call);
+
+    e.attach(MakeHeavy);
+    REQUIRE(e(7).value == 7);
+    REQUIRE(e.invoke<event::combiners::last>(8)->value == 8);
+}
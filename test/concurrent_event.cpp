@@ -0,0 +1,155 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <eventcpp/concurrent_event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    std::atomic<int> total;
+
+    void Add(int val)
+    {
+        total += val;
+    }
+
+    class Accumulator
+    {
+    public:
+        std::atomic<int> sum{ 0 };
+
+        void Add(int val)
+        {
+            sum += val;
+        }
+
+        int Get(int val)
+        {
+            return sum + val;
+        }
+    };
+}
+
+TEST_CASE("concurrent_event should notify subscribers")
+{
+    event::concurrent_event<int (int)> e;
+    Accumulator acc;
+
+    REQUIRE(e(1) == 0);
+
+    auto handle = e.attach(&Accumulator::Get, acc);
+    REQUIRE(e(1) == 1);
+    REQUIRE(e.size() == 1);
+
+    REQUIRE(e.detach(handle));
+    REQUIRE_FALSE(e.detach(handle));
+    REQUIRE(e.empty());
+}
+
+TEST_CASE("concurrent_event should be notified from many threads while subscribers change")
+{
+    event::concurrent_event<void (int)> e;
+    Accumulator acc;
+    total = 0;
+
+    e.attach(&Accumulator::Add, acc);
+
+    std::atomic<bool> stop{ false };
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&e]
+        {
+            for (int i = 0; i < 10000; i++)
+            {
+                e(1);
+            }
+        });
+    }
+
+    std::thread writer([&e, &stop]
+    {
+        while (!stop)
+        {
+            auto handle = e.attach(Add);
+            e.detach(handle);
+        }
+    });
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    stop = true;
+    writer.join();
+    e.synchronize();
+
+    REQUIRE(acc.sum == 40000);
+    REQUIRE(e.size() == 1);
+}
+
+TEST_CASE("concurrent_event should synchronize from many threads while subscribers change")
+{
+    event::concurrent_event<void (int)> e;
+    Accumulator acc;
+    total = 0;
+
+    e.attach(&Accumulator::Add, acc);
+
+    std::atomic<bool> stop{ false };
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 2; t++)
+    {
+        threads.emplace_back([&e]
+        {
+            for (int i = 0; i < 10000; i++)
+            {
+                e(1);
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+
+    for (int t = 0; t < 2; t++)
+    {
+        writers.emplace_back([&e, &stop]
+        {
+            while (!stop)
+            {
+                auto handle = e.attach(Add);
+                e.detach(handle);
+            }
+        });
+
+        writers.emplace_back([&e, &stop]
+        {
+            while (!stop)
+            {
+                e.synchronize();
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    stop = true;
+
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+
+    e.synchronize();
+
+    REQUIRE(acc.sum == 20000);
+    REQUIRE(e.size() == 1);
+}
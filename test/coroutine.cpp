@@ -0,0 +1,156 @@
+#include <eventcpp/event.hpp>
+
+#ifdef EVENTCPP_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    /**
+     * \brief Eagerly started coroutine, destroyed with its handle object
+     */
+    class task
+    {
+    public:
+        struct promise_type
+        {
+            task get_return_object()
+            {
+                return task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        explicit task(std::coroutine_handle<promise_type> handle) : _handle(handle)
+        {
+        }
+
+        task(const task&) = delete;
+        task& operator= (const task&) = delete;
+
+        ~task()
+        {
+            _handle.destroy();
+        }
+
+        bool done() const
+        {
+            return _handle.done();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    task wait_twice(event::event<void (int, const std::string&)>& e, std::vector<std::string>& log)
+    {
+        auto [x, s] = co_await e.next();
+        log.push_back(std::to_string(x) + s);
+
+        auto [y, t] = co_await e.next();
+        log.push_back(std::to_string(y) + t);
+    }
+
+    task consume(event::small_event<void (int), 2>& e, std::vector<int>& log, int count)
+    {
+        auto values = e.stream();
+
+        for (int i = 0; i < count; i++)
+        {
+            auto [x] = co_await values.next();
+            log.push_back(x);
+
+            if (x == 1)
+                e(100);
+        }
+    }
+}
+
+TEST_CASE("event should resume a coroutine awaiting the next notification")
+{
+    event::event<void (int, const std::string&)> e;
+    std::vector<std::string> log;
+    int calls = 0;
+
+    e.attach([&calls](int, const std::string&) { calls++; });
+
+    auto t = wait_twice(e, log);
+    REQUIRE(e.size() == 2);
+    REQUIRE_FALSE(t.done());
+
+    e(1, "a");
+    REQUIRE(log == std::vector<std::string>{ "1a" });
+    REQUIRE(calls == 1);
+
+    e(2, "b");
+    REQUIRE(log == std::vector<std::string>{ "1a", "2b" });
+    REQUIRE(t.done());
+    REQUIRE(e.size() == 1);
+
+    e(3, "c");
+    REQUIRE(log.size() == 2);
+}
+
+TEST_CASE("event should detach the awaiter of a destroyed coroutine")
+{
+    event::event<void (int, const std::string&)> e;
+    std::vector<std::string> log;
+
+    {
+        auto t = wait_twice(e, log);
+        REQUIRE(e.size() == 1);
+    }
+
+    REQUIRE(e.empty());
+    e(1, "a");
+    REQUIRE(log.empty());
+}
+
+TEST_CASE("event stream should queue notifications made while the coroutine runs")
+{
+    event::small_event<void (int), 2> e;
+    std::vector<int> log;
+
+    {
+        auto t = consume(e, log, 3);
+        REQUIRE(e.size() == 1);
+
+        e(1);
+        REQUIRE(log == std::vector<int>{ 1, 100 });
+
+        e(2);
+        REQUIRE(t.done());
+        REQUIRE(log == std::vector<int>{ 1, 100, 2 });
+    }
+
+    REQUIRE(e.empty());
+}
+
+TEST_CASE("noexcept event should be awaited")
+{
+    event::event<void (int) noexcept> e;
+    int value = 0;
+
+    auto waiter = [](event::event<void (int) noexcept>& e, int& value) -> task
+    {
+        std::tie(value) = co_await e.next();
+    };
+
+    auto t = waiter(e, value);
+    e(7);
+
+    REQUIRE(value == 7);
+    REQUIRE(t.done());
+}
+
+#endif
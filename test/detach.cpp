@@ -0,0 +1,117 @@
+#include <vector>
+
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    int Ten(int)
+    {
+        return 10;
+    }
+
+    class Shape
+    {
+    public:
+        virtual int Area(int val) = 0;
+    };
+
+    class Square : public Shape
+    {
+    public:
+        int Area(int val) override
+        {
+            return val * val;
+        }
+
+        int Side(int val)
+        {
+            return val;
+        }
+    };
+
+    class Tagged
+    {
+        int _tag;
+
+    public:
+        Tagged(int tag) : _tag(tag) {}
+
+        int Tag(int)
+        {
+            return _tag;
+        }
+    };
+}
+
+TEST_CASE("event should detach the matching subscriber only")
+{
+    event::event<int (int)> e;
+
+    SECTION("same member function on different objects")
+    {
+        Tagged t1(1), t2(2);
+        e.attach(&Tagged::Tag, t1);
+        e.attach(&Tagged::Tag, t2);
+
+        e.detach(&Tagged::Tag, t2);
+        REQUIRE(e(0) == 1);
+        REQUIRE(e.size() == 1);
+    }
+    SECTION("function sharing no object with a member subscriber")
+    {
+        Tagged t1(1);
+        e.attach(&Tagged::Tag, t1);
+        e.attach(Ten);
+
+        e.detach(Ten);
+        REQUIRE(e(0) == 1);
+    }
+    SECTION("member function detached through base class")
+    {
+        Square sq;
+        e.attach(&Square::Side, sq);
+        e.attach(&Square::Area, sq);
+
+        e.detach(&Shape::Area, sq);
+        REQUIRE(e(3) == 3);
+    }
+    SECTION("callback that is not attached")
+    {
+        Tagged t1(1);
+        e.attach(&Tagged::Tag, t1);
+
+        e.detach(Ten);
+        REQUIRE(e.size() == 1);
+    }
+}
+
+TEST_CASE("event should detach by callback among many subscribers")
+{
+    event::event<int (int)> e;
+    std::vector<Tagged> objs;
+
+    for (int i = 0; i < 100; i++)
+    {
+        objs.emplace_back(i);
+    }
+
+    for (auto& obj : objs)
+    {
+        e.attach(&Tagged::Tag, obj);
+    }
+
+    for (int i = 99; i > 0; i--)
+    {
+        e.detach(&Tagged::Tag, objs[i]);
+        REQUIRE(e(0) == i - 1);
+        REQUIRE(e.size() == static_cast<std::size_t>(i));
+    }
+
+    e.attach(Ten);
+    e.attach(Ten);
+    e.detach(Ten);
+    REQUIRE(e.size() == 2);
+    REQUIRE(e(0) == 10);
+}
@@ -0,0 +1,94 @@
+#include <eventcpp/event_bus.hpp>
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Connected
+    {
+        int id;
+    };
+
+    struct Received
+    {
+        int id;
+        std::string payload;
+    };
+
+    struct Closed
+    {
+        int id;
+    };
+
+    class Session
+    {
+    public:
+        std::vector<std::string> log;
+
+        void OnConnected(const Connected& m)
+        {
+            log.push_back("connected " + std::to_string(m.id));
+        }
+
+        void OnReceived(const Received& m)
+        {
+            log.push_back(m.payload);
+        }
+    };
+
+    using bus_type = event::event_bus<Connected, Received, Closed>;
+
+    static_assert(bus_type::carries<Received>, "bus must carry declared messages");
+    static_assert(!bus_type::carries<int>, "bus must not carry undeclared messages");
+}
+
+TEST_CASE("event_bus should route messages to the channel of their type")
+{
+    bus_type bus;
+    Session s;
+    int closed = 0;
+
+    REQUIRE(bus.empty());
+
+    bus.attach<Connected>(&Session::OnConnected, s);
+    bus.channel<Received>().attach<&Session::OnReceived>(s);
+    auto handle = bus.attach<Closed>([&closed](const Closed& m) { closed += m.id; });
+
+    bus.publish(Connected{ 1 });
+    bus.publish(Received{ 1, "hello" });
+    bus.publish(Closed{ 1 });
+
+    REQUIRE(s.log == std::vector<std::string>{ "connected 1", "hello" });
+    REQUIRE(closed == 1);
+
+    bus.detach<Connected>(&Session::OnConnected, s);
+    REQUIRE(bus.detach<Closed>(handle));
+
+    bus.publish(Connected{ 2 });
+    bus.publish(Closed{ 2 });
+
+    REQUIRE(s.log.size() == 2);
+    REQUIRE(closed == 1);
+    REQUIRE_FALSE(bus.empty());
+
+    bus.channel<Received>().detach<&Session::OnReceived>(s);
+    REQUIRE(bus.empty());
+}
+
+TEST_CASE("event_bus should be published to through a const reference")
+{
+    bus_type bus;
+    const auto& cbus = bus;
+    int total = 0;
+
+    bus.attach<Received>([&total](const Received& m) { total += m.id; });
+    bus.attach<Received>([&total](const Received& m) { total += static_cast<int>(m.payload.size()); }, 1);
+
+    cbus.publish(Received{ 10, "abc" });
+    REQUIRE(total == 13);
+    REQUIRE(cbus.channel<Received>().size() == 2);
+    REQUIRE(cbus.channel<Connected>().empty());
+}
@@ -0,0 +1,166 @@
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Payload
+    {
+        static int copies;
+        static int moves;
+
+        std::vector<int> data;
+
+        Payload(std::vector<int> d) : data(std::move(d)) {}
+        Payload(const Payload& other) : data(other.data) { copies++; }
+        Payload(Payload&& other) noexcept : data(std::move(other.data)) { moves++; }
+    };
+
+    int Payload::copies = 0;
+    int Payload::moves = 0;
+
+    int Increment(int val)
+    {
+        return val + 1;
+    }
+
+    class Sink
+    {
+    public:
+        std::vector<std::string> received;
+        std::size_t total = 0;
+
+        void Take(std::string val)
+        {
+            received.push_back(std::move(val));
+        }
+
+        void Consume(Payload payload)
+        {
+            total += payload.data.size();
+        }
+
+        void Append(std::string& val)
+        {
+            val += "!";
+        }
+    };
+}
+
+TEST_CASE("event should pass arguments to every subscriber intact")
+{
+    Sink s1, s2, s3;
+
+    SECTION("by value arguments are not moved from before the last subscriber")
+    {
+        event::event<void (std::string)> e;
+        e.attach(&Sink::Take, s1);
+        e.attach(&Sink::Take, s2);
+        e.attach(&Sink::Take, s3);
+
+        std::string val = "a long enough string to defeat small string optimisation";
+        e(val);
+
+        REQUIRE(s1.received.front() == val);
+        REQUIRE(s2.received.front() == val);
+        REQUIRE(s3.received.front() == val);
+    }
+    SECTION("last subscriber receives a moved argument")
+    {
+        event::event<void (Payload)> e;
+        e.attach(&Sink::Consume, s1);
+        e.attach(&Sink::Consume, s2);
+        e.attach(&Sink::Consume, s3);
+
+        Payload::copies = 0;
+        e(Payload({ 1, 2, 3 }));
+
+        REQUIRE(Payload::copies == 2);
+        REQUIRE(s1.total == 3);
+        REQUIRE(s2.total == 3);
+        REQUIRE(s3.total == 3);
+    }
+    SECTION("reference arguments are shared")
+    {
+        event::event<void (std::string&)> e;
+        e.attach(&Sink::Append, s1);
+        e.attach(&Sink::Append, s2);
+
+        std::string val = "hi";
+        e(val);
+
+        REQUIRE(val == "hi!!");
+    }
+    SECTION("lvalue arguments")
+    {
+        event::event<int (int)> e;
+        e.attach(Increment);
+
+        int val = 2;
+        REQUIRE(e(val) == 3);
+    }
+}
+
+TEST_CASE("event should pass move-only arguments taken by reference to every subscriber")
+{
+    static_assert(!std::is_copy_constructible<std::unique_ptr<int>>::value, "argument must be move-only");
+
+    int seen = 0;
+
+    SECTION("rvalue reference")
+    {
+        event::event<void (std::unique_ptr<int>&&)> e;
+        e.attach([&seen](std::unique_ptr<int>&& p) { seen += p != nullptr; });
+        e.attach([&seen](const std::unique_ptr<int>& p) { seen += p != nullptr; });
+        e.attach([&seen](auto&& p) { seen += p != nullptr; });
+
+        e(std::make_unique<int>(1));
+
+        REQUIRE(seen == 3);
+    }
+    SECTION("const reference")
+    {
+        event::event<void (const std::unique_ptr<int>&)> e;
+        e.attach([&seen](const std::unique_ptr<int>& p) { seen += *p; });
+        e.attach([&seen](const std::unique_ptr<int>& p) { seen += *p; });
+
+        auto p = std::make_unique<int>(2);
+        e(p);
+
+        REQUIRE(seen == 4);
+        REQUIRE(p != nullptr);
+    }
+}
+
+TEST_CASE("event should reject subscribers taking rvalue reference arguments by value")
+{
+    using event::details::takes_rvalue_by_value_v;
+
+    auto by_value = [](std::unique_ptr<int> p) { return p != nullptr; };
+    auto by_reference = [](std::unique_ptr<int>&& p) { return p != nullptr; };
+
+    // the first subscriber taking the pointer by value would empty it for the ones after it
+    static_assert(takes_rvalue_by_value_v<decltype(by_value), std::unique_ptr<int>&&>, "by value lambda must be rejected");
+    static_assert(takes_rvalue_by_value_v<void (*)(std::string), std::string&&>, "by value function must be rejected");
+    static_assert(takes_rvalue_by_value_v<decltype(&Sink::Take), std::string&&>, "by value member function must be rejected");
+    static_assert(!takes_rvalue_by_value_v<decltype(by_reference), std::unique_ptr<int>&&>, "rvalue reference must be accepted");
+    static_assert(!takes_rvalue_by_value_v<decltype(by_value), const std::unique_ptr<int>&>, "const reference must be accepted");
+    static_assert(!takes_rvalue_by_value_v<void (*)(std::string), std::string>, "copies must be accepted");
+
+    event::event<void (std::string&&)> e;
+    std::string first, second;
+
+    e.attach([&first](const std::string& s) { first = s; });
+    e.attach([&second](std::string&& s) { second = std::move(s); });
+
+    e(std::string("payload"));
+
+    REQUIRE(first == "payload");
+    REQUIRE(second == "payload");
+}
@@ -0,0 +1,254 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/combiners.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    std::vector<int> order;
+
+    void Router(int) { order.push_back(1); }
+    void Metrics(int) { order.push_back(2); }
+    void Logger(int) { order.push_back(3); }
+
+    class Listener : public event::tracked
+    {
+    public:
+        int calls = 0;
+
+        void Handle(int)
+        {
+            calls++;
+        }
+    };
+
+    class Counter
+    {
+    public:
+        std::atomic<int> calls{ 0 };
+
+        void Handle(int x)
+        {
+            calls += x;
+        }
+    };
+}
+
+TEST_CASE("frozen event should notify subscribers in priority order")
+{
+    event::event<void (int)> e;
+    order.clear();
+
+    e.attach(&Logger, -10);
+    e.attach(&Metrics);
+    e.attach(&Router, 100);
+
+    auto frozen = e.freeze();
+
+    frozen(0);
+
+    REQUIRE(frozen.size() == 3);
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+}
+
+TEST_CASE("frozen event should not be affected by changes to the event")
+{
+    event::event<void (int)> e;
+    int calls = 0;
+
+    e.attach(&Router);
+    e.attach([&calls](int x) { calls += x; });
+
+    auto frozen = e.freeze();
+
+    e.detach(&Router);
+    e.attach(&Logger);
+    order.clear();
+
+    frozen(2);
+
+    REQUIRE(order == std::vector<int>{ 1 });
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("frozen event should notify a free function attached twice once")
+{
+    event::event<void (int)> e;
+    Counter c;
+    order.clear();
+
+    e.attach(&Router);
+    e.attach(&Metrics);
+    e.attach(&Router);
+    e.attach<&Logger>();
+    e.attach<&Logger>();
+    e.attach(&Counter::Handle, c);
+    e.attach(&Counter::Handle, c);
+
+    auto frozen = e.freeze();
+
+    frozen(1);
+
+    REQUIRE(frozen.size() == 5);
+    REQUIRE(order.size() == 3);
+    REQUIRE(c.calls == 2);
+}
+
+TEST_CASE("frozen event should group subscribers of a priority by thunk")
+{
+    event::event<void (int)> e;
+    Listener l1, l2;
+    order.clear();
+
+    e.attach(&Router);
+    e.attach(&Listener::Handle, l1);
+    e.attach(&Metrics);
+    e.attach(&Listener::Handle, l2);
+    e.attach(&Logger, 1);
+
+    auto frozen = e.freeze();
+
+    frozen(0);
+
+    REQUIRE(order.front() == 3);
+    REQUIRE((order == std::vector<int>{ 3, 1, 2 } || order == std::vector<int>{ 3, 2, 1 }));
+    REQUIRE(l1.calls == 1);
+    REQUIRE(l2.calls == 1);
+}
+
+TEST_CASE("frozen event should return the result of the last subscriber")
+{
+    event::event<int (int)> e;
+
+    auto frozen_empty = e.freeze();
+
+    REQUIRE(frozen_empty(1) == 0);
+
+    e.attach([](int x) { return x + 1; });
+    e.attach([](int x) { return x * 10; }, -1);
+
+    auto frozen = e.freeze();
+
+    REQUIRE(frozen(3) == 30);
+    REQUIRE(frozen.invoke(event::combiners::sum<int>(), 3) == 34);
+}
+
+TEST_CASE("frozen event should stop at a subscriber returning stop")
+{
+    event::event<event::dispatch_result (int)> e;
+    int calls = 0;
+
+    e.attach([&calls](int) { calls++; return event::dispatch_result::stop; }, 1);
+    e.attach([&calls](int) { calls++; return event::dispatch_result::proceed; });
+
+    auto frozen = e.freeze();
+
+    REQUIRE(frozen(0) == event::dispatch_result::stop);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("frozen event should keep callables kept on the heap alive")
+{
+    auto text = std::make_shared<std::string>("abc");
+    std::size_t length = 0;
+
+    event::frozen_event<void (int)> frozen = [&]
+    {
+        event::event<void (int)> e;
+
+        e.attach([text, &length](int x) { length = text->size() + x; });
+
+        return e.freeze();
+    }();
+
+    text.reset();
+    frozen(1);
+
+    REQUIRE(length == 4);
+
+    auto copy = frozen;
+    auto moved = std::move(frozen);
+
+    copy(2);
+    REQUIRE(length == 5);
+
+    moved(3);
+    REQUIRE(length == 6);
+}
+
+TEST_CASE("frozen event should skip subscribers of destroyed tracked objects")
+{
+    event::event<void (int)> e;
+    Counter c;
+    auto l1 = std::make_unique<Listener>();
+    Listener l2;
+
+    e.attach(&Counter::Handle, c);
+    e.attach(&Listener::Handle, *l1);
+    e.attach(&Listener::Handle, l2);
+
+    auto frozen = e.freeze();
+
+    l1.reset();
+    frozen(1);
+
+    REQUIRE(c.calls == 1);
+    REQUIRE(l2.calls == 1);
+}
+
+TEST_CASE("frozen event should keep the noexcept signature")
+{
+    event::event<void (int) noexcept> e;
+
+    e.attach(+[](int) noexcept {});
+
+    auto frozen = e.freeze();
+
+    static_assert(std::is_same<decltype(frozen), event::frozen_event<void (int) noexcept>>::value,
+        "frozen event keeps the noexcept signature");
+    static_assert(noexcept(frozen(0)), "notifying a frozen noexcept event does not throw");
+
+    REQUIRE(frozen.size() == 1);
+}
+
+TEST_CASE("frozen event should be notified concurrently")
+{
+    event::event<void (int)> e;
+    std::vector<Counter> counters(64);
+
+    for (auto& c : counters)
+    {
+        e.attach(&Counter::Handle, c);
+    }
+
+    const auto frozen = e.freeze();
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&frozen]
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                frozen(1);
+            }
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (auto& c : counters)
+    {
+        REQUIRE(c.calls == 4000);
+    }
+}
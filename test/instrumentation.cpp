@@ -0,0 +1,143 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/instrumentation.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    /**
+     * \brief Clock advanced by hand, so subscriber durations are exact
+     */
+    struct manual_clock
+    {
+        using rep = std::int64_t;
+        using period = std::nano;
+        using duration = std::chrono::duration<rep, period>;
+        using time_point = std::chrono::time_point<manual_clock>;
+
+        static inline rep ticks = 0;
+
+        static time_point now() noexcept
+        {
+            return time_point(duration(ticks));
+        }
+    };
+
+    int Work(int x)
+    {
+        manual_clock::ticks += x;
+        return x;
+    }
+
+    int Slow(int x)
+    {
+        manual_clock::ticks += 10 * x;
+        return 2 * x;
+    }
+
+    /**
+     * \brief Policy forwarding every measurement to a log
+     */
+    struct recording_sink
+    {
+        static constexpr bool enabled = true;
+
+        using clock = manual_clock;
+
+        std::vector<std::size_t> dispatches;
+        std::vector<event::subscription> calls;
+
+        void on_dispatch(std::size_t subscribers) noexcept
+        {
+            dispatches.push_back(subscribers);
+        }
+
+        void on_call(event::subscription subscriber, clock::duration) noexcept
+        {
+            calls.push_back(subscriber);
+        }
+    };
+}
+
+TEST_CASE("event should record notifications and the slowest subscriber")
+{
+    manual_clock::ticks = 0;
+
+    event::event<int (int), event::dispatch_stats<manual_clock>> e;
+
+    e.attach(Work);
+    auto slow = e.attach(Slow);
+    e.attach(Work, -1);
+
+    REQUIRE(e(1) == 1);
+    REQUIRE(e.dispatch<event::until_true>(2) == 2);
+
+    const auto& stats = e.instrumentation();
+    REQUIRE(stats.dispatches() == 2);
+    REQUIRE(stats.calls() == 4);
+    REQUIRE(stats.subscribers() == 3);
+    REQUIRE(stats.total() == std::chrono::nanoseconds(1 + 10 + 1 + 2));
+    REQUIRE(stats.slowest() == slow);
+    REQUIRE(stats.slowest_time() == std::chrono::nanoseconds(10));
+
+    e.instrumentation().reset();
+    REQUIRE(e.instrumentation().calls() == 0);
+    REQUIRE_FALSE(e.instrumentation().slowest().valid());
+}
+
+TEST_CASE("event should report every dispatch and call to a policy")
+{
+    event::small_event<void (int), 2, recording_sink> e;
+    std::vector<event::subscription> handles;
+
+    handles.push_back(e.attach(Work));
+    handles.push_back(e.attach([&e, &handles](int) { e.detach(handles.front()); }, 1));
+
+    e(1);
+    e(1);
+    e.notify_batch(event::span<const int>(nullptr, 0));
+
+    auto& sink = e.instrumentation();
+    REQUIRE(sink.dispatches == std::vector<std::size_t>{ 2, 1, 1 });
+    REQUIRE(sink.calls == std::vector<event::subscription>{ handles[1], handles[1], handles[1] });
+
+    auto copy = e;
+    REQUIRE(copy.instrumentation().dispatches.empty());
+}
+
+TEST_CASE("dispatch_stats should count notifications of a const event from several threads")
+{
+    event::event<int (int), event::dispatch_stats<>> e;
+
+    e.attach([](int x) { return x; });
+    e.attach([](int x) { return -x; });
+
+    const auto& notifier = e;
+    auto fire = [&notifier]()
+    {
+        for (int i = 0; i < 1000; i++)
+            notifier(i);
+    };
+
+    std::thread first(fire);
+    std::thread second(fire);
+
+    first.join();
+    second.join();
+
+    const auto& stats = e.instrumentation();
+    REQUIRE(stats.dispatches() == 2000);
+    REQUIRE(stats.calls() == 4000);
+    REQUIRE(stats.subscribers() == 2);
+    REQUIRE(stats.slowest().valid());
+    REQUIRE(stats.total() >= stats.slowest_time());
+
+    auto snapshot = stats;
+    REQUIRE(snapshot.calls() == 4000);
+    REQUIRE(snapshot.slowest() == stats.slowest());
+}
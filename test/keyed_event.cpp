@@ -0,0 +1,103 @@
+#include <eventcpp/keyed_event.hpp>
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Tick
+    {
+        int instrument;
+        double price;
+    };
+
+    class Book
+    {
+    public:
+        std::vector<double> prices;
+
+        void OnTick(const Tick& t)
+        {
+            prices.push_back(t.price);
+        }
+    };
+}
+
+TEST_CASE("keyed_event should notify subscribers of the key and wildcards only")
+{
+    event::keyed_event<int, void (const Tick&)> e;
+    Book first, second;
+    std::vector<int> all;
+
+    e.attach(1, &Book::OnTick, first);
+    e.channel(2).attach<&Book::OnTick>(second);
+    e.attach_any([&all](const Tick& t) { all.push_back(t.instrument); });
+
+    e(1, Tick{ 1, 10.0 });
+    e(2, Tick{ 2, 20.0 });
+    e(3, Tick{ 3, 30.0 });
+
+    REQUIRE(first.prices == std::vector<double>{ 10.0 });
+    REQUIRE(second.prices == std::vector<double>{ 20.0 });
+    REQUIRE(all == std::vector<int>{ 1, 2, 3 });
+    REQUIRE(e.size(1) == 1);
+    REQUIRE(e.size(3) == 0);
+    REQUIRE(e.keys() == 2);
+}
+
+TEST_CASE("keyed_event should drop channels of keys without subscribers")
+{
+    event::keyed_event<std::string, void (int)> e;
+    int calls = 0;
+
+    auto handle = e.attach("a", [&calls](int) { calls++; });
+    e.attach("b", [&calls](int) { calls++; });
+
+    REQUIRE_FALSE(e.detach("b", event::subscription()));
+    REQUIRE_FALSE(e.detach("c", handle));
+    REQUIRE(e.detach("a", handle));
+    REQUIRE_FALSE(e.detach("a", handle));
+    REQUIRE(e.keys() == 1);
+
+    e("a", 1);
+    REQUIRE(calls == 0);
+
+    REQUIRE_FALSE(e.empty());
+    auto any = e.attach_any([&calls](int) { calls += 10; });
+    e("a", 1);
+    REQUIRE(calls == 10);
+
+    REQUIRE(e.detach_any(any));
+    e.wildcard().attach([&calls](int) { calls += 100; });
+    e("b", 1);
+    REQUIRE(calls == 111);
+}
+
+TEST_CASE("keyed_event subscribers may attach and detach while being notified")
+{
+    event::keyed_event<int, void (int)> e;
+    std::vector<int> calls;
+    event::subscription self;
+
+    self = e.attach(1, [&](int x)
+    {
+        calls.push_back(x);
+        e.detach(1, self);
+
+        for (int key = 2; key < 64; key++)
+        {
+            e.attach(key, [&calls, key](int) { calls.push_back(key); });
+        }
+    });
+
+    e(1, 1);
+    REQUIRE(calls == std::vector<int>{ 1 });
+    REQUIRE(e.size(1) == 0);
+    REQUIRE(e.keys() == 62);
+
+    e(1, 1);
+    e(5, 1);
+    REQUIRE(calls == std::vector<int>{ 1, 5 });
+}
@@ -0,0 +1,231 @@
+#include <eventcpp/event.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class counting_resource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocated = 0;
+        std::size_t outstanding = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            allocated++;
+            outstanding++;
+
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            outstanding--;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    /**
+     * \brief Installs a counting resource as the default resource for a scope
+     */
+    class default_resource_guard
+    {
+    public:
+        counting_resource resource;
+
+        default_resource_guard() : _previous(std::pmr::set_default_resource(&resource))
+        {
+        }
+
+        ~default_resource_guard()
+        {
+            std::pmr::set_default_resource(_previous);
+        }
+
+    private:
+        std::pmr::memory_resource* _previous;
+    };
+
+    /**
+     * \brief Resource failing every allocation once a number of them succeeded
+     */
+    class failing_resource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t remaining;
+
+        explicit failing_resource(std::size_t r) : remaining(r)
+        {
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            if (remaining == 0)
+                throw std::bad_alloc();
+
+            remaining--;
+
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    class Counter
+    {
+    public:
+        int calls = 0;
+
+        void Count(int)
+        {
+            calls++;
+        }
+    };
+}
+
+TEST_CASE("event should allocate from its memory resource only")
+{
+    default_resource_guard fallback;
+    counting_resource resource;
+    std::vector<Counter> counters(100);
+
+    {
+        event::event<void (int)> e(&resource);
+        REQUIRE(e.resource() == &resource);
+
+        for (auto& c : counters)
+        {
+            e.attach(&Counter::Count, c);
+        }
+
+        std::array<int, 16> payload{};
+        int total = 0;
+        auto handle = e.attach([payload, &total](int x) { total += x + payload[0]; });
+
+        e(1);
+        REQUIRE(total == 1);
+        REQUIRE(counters.back().calls == 1);
+
+        e.detach(&Counter::Count, counters.front());
+        REQUIRE(e.detach(handle));
+        REQUIRE(resource.allocated > 0);
+    }
+
+    REQUIRE(resource.outstanding == 0);
+    REQUIRE(fallback.resource.allocated == 0);
+}
+
+TEST_CASE("event should run on a monotonic buffer")
+{
+    std::array<std::byte, 16 * 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::vector<Counter> counters(40);
+
+    event::small_event<void (int), 4> e(&arena);
+
+    for (auto& c : counters)
+    {
+        e.attach(&Counter::Count, c);
+    }
+
+    e(1);
+
+    for (const auto& c : counters)
+    {
+        REQUIRE(c.calls == 1);
+    }
+}
+
+TEST_CASE("event copies should use the default resource and moves keep it")
+{
+    counting_resource resource;
+    Counter c1, c2;
+
+    event::event<void (int)> e(&resource);
+    e.attach(&Counter::Count, c1);
+    e.attach(&Counter::Count, c2);
+
+    auto copy = e;
+    REQUIRE(copy.resource() == std::pmr::get_default_resource());
+
+    auto moved = std::move(e);
+    REQUIRE(moved.resource() == &resource);
+
+    event::event<void (int)> other;
+    other = std::move(moved);
+    REQUIRE(other.resource() == std::pmr::get_default_resource());
+    REQUIRE(other.size() == 2);
+
+    other(1);
+    copy(1);
+    REQUIRE(c1.calls == 2);
+    REQUIRE(c2.calls == 2);
+}
+
+TEST_CASE("event should be left unchanged by an attach failing around the index threshold")
+{
+    for (std::size_t budget = 0; budget < 200; budget++)
+    {
+        failing_resource resource(budget);
+        std::vector<Counter> counters(40);
+        std::size_t calls = 0;
+        std::size_t members = 0;
+        std::size_t closures = 0;
+
+        event::event<void (int)> e(&resource);
+
+        try
+        {
+            for (auto& c : counters)
+            {
+                e.attach(&Counter::Count, c);
+                members++;
+
+                // too large to be stored inline, so it is kept in a closure allocated from the resource
+                e.attach([&calls, padding = std::array<char, 64>()](int) { calls += 1 + padding[0]; });
+                closures++;
+            }
+        }
+        catch (const std::bad_alloc&)
+        {
+        }
+
+        resource.remaining = ~std::size_t(0);
+
+        REQUIRE(e.size() == members + closures);
+
+        e(1);
+        REQUIRE(calls == closures);
+
+        for (std::size_t i = 0; i < members; i++)
+        {
+            REQUIRE(counters[i].calls == 1);
+
+            // found through the index once there are enough subscribers
+            e.detach(&Counter::Count, counters[i]);
+            REQUIRE(e.size() == members - i - 1 + closures);
+        }
+    }
+}
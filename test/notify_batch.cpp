@@ -0,0 +1,105 @@
+#include <vector>
+
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Tick
+    {
+        int price;
+    };
+
+    std::vector<int> batches;
+
+    void OnBatch(event::span<const Tick> ticks)
+    {
+        batches.push_back(static_cast<int>(ticks.size()));
+    }
+
+    class Book
+    {
+    public:
+        std::vector<int> prices;
+        int batches = 0;
+
+        void OnTick(const Tick& tick)
+        {
+            prices.push_back(tick.price);
+        }
+
+        void OnBatch(event::span<const Tick> ticks)
+        {
+            batches++;
+
+            for (const auto& tick : ticks)
+            {
+                prices.push_back(tick.price);
+            }
+        }
+    };
+}
+
+TEST_CASE("event should notify subscribers with a batch of payloads")
+{
+    event::event<void (const Tick&)> e;
+    std::vector<Tick> ticks = { { 1 }, { 2 }, { 3 } };
+    Book single, batched;
+    batches.clear();
+
+    e.attach(&Book::OnTick, single);
+    e.attach_batch<&Book::OnBatch>(batched);
+    e.attach_batch(OnBatch);
+
+    SECTION("every subscriber sees every payload in order")
+    {
+        e.notify_batch(ticks);
+
+        REQUIRE(single.prices == std::vector<int>{ 1, 2, 3 });
+        REQUIRE(batched.prices == std::vector<int>{ 1, 2, 3 });
+        REQUIRE(batched.batches == 1);
+        REQUIRE(batches == std::vector<int>{ 3 });
+    }
+    SECTION("batch subscribers receive single notifications as a batch of one")
+    {
+        e(Tick{ 7 });
+
+        REQUIRE(single.prices == std::vector<int>{ 7 });
+        REQUIRE(batched.prices == std::vector<int>{ 7 });
+        REQUIRE(batches == std::vector<int>{ 1 });
+    }
+    SECTION("batch subscribers can be detached")
+    {
+        e.detach_batch(OnBatch);
+        e.detach_batch<&Book::OnBatch>(batched);
+        e.notify_batch(event::span<const Tick>(ticks.data(), 2));
+
+        REQUIRE(single.prices == std::vector<int>{ 1, 2 });
+        REQUIRE(batched.batches == 0);
+        REQUIRE(batches.empty());
+    }
+}
+
+TEST_CASE("event taking payload by value should notify with a batch")
+{
+    event::event<void (Tick)> e;
+    Tick ticks[] = { { 4 }, { 5 } };
+    int sum = 0;
+
+    class Summer
+    {
+    public:
+        int* sum;
+
+        void Add(Tick tick)
+        {
+            *sum += tick.price;
+        }
+    } summer{ &sum };
+
+    e.attach(&Summer::Add, summer);
+    e.notify_batch(ticks);
+
+    REQUIRE(sum == 9);
+}
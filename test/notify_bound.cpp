@@ -0,0 +1,72 @@
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    int Square(int val)
+    {
+        return val * val;
+    }
+
+    class Base
+    {
+    public:
+        virtual int Apply(int val) = 0;
+    };
+
+    class Negate : public Base
+    {
+    public:
+        int Apply(int val) override
+        {
+            return -val;
+        }
+
+        static int Twice(int val)
+        {
+            return val * 2;
+        }
+    };
+}
+
+TEST_CASE("event should notify subscribers bound at compile time")
+{
+    event::event<int (int)> e;
+    Negate obj;
+
+    SECTION("function subscriber")
+    {
+        e.attach<&Square>();
+
+        REQUIRE(e(3) == 9);
+    }
+    SECTION("static member function subscriber")
+    {
+        e.attach<&Negate::Twice>();
+
+        REQUIRE(e(3) == 6);
+    }
+    SECTION("member function subscriber on reference")
+    {
+        e.attach<&Negate::Apply>(obj);
+
+        REQUIRE(e(3) == -3);
+    }
+    SECTION("virtual member function subscriber on pointer")
+    {
+        Base* base = &obj;
+        e.attach<&Base::Apply>(base);
+
+        REQUIRE(e(3) == -3);
+    }
+    SECTION("mixed with runtime subscribers and detached")
+    {
+        e.attach(Square);
+        e.attach<&Negate::Apply>(obj);
+        REQUIRE(e(3) == -3);
+
+        e.detach<&Negate::Apply>(obj);
+        REQUIRE(e(3) == 9);
+    }
+}
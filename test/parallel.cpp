@@ -0,0 +1,150 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/combiners.hpp>
+#include <eventcpp/executor.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class Worker : public event::tracked
+    {
+    public:
+        int calls = 0;
+        std::size_t length = 0;
+
+        void Recalculate(const std::string& trigger)
+        {
+            calls++;
+            length = trigger.size();
+        }
+    };
+}
+
+TEST_CASE("event should notify every subscriber once in parallel")
+{
+    event::thread_pool pool(4);
+    event::event<void (const std::string&)> e;
+    std::vector<Worker> workers(5000);
+    std::atomic<int> total{ 0 };
+
+    for (auto& w : workers)
+    {
+        e.attach(&Worker::Recalculate, w);
+    }
+
+    e.attach([&total](const std::string&) { total++; });
+
+    std::string trigger = "end of day";
+    e.fire_parallel(pool, trigger);
+    e.fire_parallel(pool, trigger);
+
+    for (const auto& w : workers)
+    {
+        REQUIRE(w.calls == 2);
+        REQUIRE(w.length == trigger.size());
+    }
+
+    REQUIRE(total == 2);
+}
+
+TEST_CASE("event should combine results of a parallel notification in order")
+{
+    event::thread_pool pool(3);
+    event::event<int (int)> e;
+    event::inline_executor inline_executor;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        e.attach([i](int x) { return i * x; }, i % 3);
+    }
+
+    REQUIRE(e.invoke_parallel(pool, event::combiners::sum<int>(), 2) == e.invoke<event::combiners::sum>(2));
+    REQUIRE(e.invoke_parallel(pool, event::combiners::first<int>(), 1) == e.invoke<event::combiners::first>(1));
+    REQUIRE(e.invoke_parallel(inline_executor, event::combiners::last<int>(), 3) ==
+        e.invoke<event::combiners::last>(3));
+
+    event::event<int (int)> few;
+    few.attach([](int x) { return x; });
+    REQUIRE(few.invoke_parallel(pool, event::combiners::sum<int>(), 5) == 5);
+}
+
+TEST_CASE("parallel notification should rethrow once every chunk completed")
+{
+    event::thread_pool pool(2);
+    event::event<void (int)> e;
+    std::atomic<int> calls{ 0 };
+
+    for (int i = 0; i < 2000; i++)
+    {
+        e.attach([&calls, i](int)
+        {
+            calls++;
+
+            if (i % 700 == 0)
+                throw std::runtime_error("failed");
+        });
+    }
+
+    REQUIRE_THROWS_AS(e.fire_parallel(pool, 1), std::runtime_error);
+    REQUIRE(calls >= 3);
+    REQUIRE(calls <= 2000);
+}
+
+TEST_CASE("parallel notification should complete from a saturated pool")
+{
+    event::thread_pool pool(1);
+    event::event<void (int)> e;
+    std::atomic<int> calls{ 0 };
+    std::atomic<bool> finished{ false };
+
+    for (int i = 0; i < 1000; i++)
+    {
+        e.attach([&calls](int) { calls++; });
+    }
+
+    pool.execute([&]
+    {
+        e.fire_parallel(pool, 1);
+        finished = true;
+    });
+
+    while (!finished)
+    {
+        std::this_thread::yield();
+    }
+
+    REQUIRE(calls == 1000);
+}
+
+TEST_CASE("parallel notification should skip expired tracked subscribers")
+{
+    event::thread_pool pool(2);
+    event::event<void (const std::string&)> e;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    for (int i = 0; i < 600; i++)
+    {
+        workers.push_back(std::make_unique<Worker>());
+        e.attach(&Worker::Recalculate, *workers.back());
+    }
+
+    workers.resize(300);
+
+    e.fire_parallel(pool, "tick");
+    REQUIRE(e.size() == 300);
+
+    e("tick");
+    REQUIRE(e.size() == 300);
+
+    for (const auto& w : workers)
+    {
+        REQUIRE(w->calls == 2);
+    }
+}
@@ -0,0 +1,132 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/concurrent_event.hpp>
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    std::vector<int> order;
+
+    class Recorder
+    {
+    public:
+        int tag;
+
+        Recorder(int t) : tag(t) {}
+
+        void Record()
+        {
+            order.push_back(tag);
+        }
+    };
+
+    void Router() { order.push_back(1); }
+    void Metrics() { order.push_back(2); }
+    void Logger() { order.push_back(3); }
+}
+
+TEST_CASE("event should notify subscribers with higher priority first")
+{
+    event::event<void()> e;
+    order.clear();
+
+    e.attach(&Logger, -10);
+    e.attach(&Metrics);
+    e.attach(&Router, 100);
+
+    e();
+
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+}
+
+TEST_CASE("event should keep attach order among subscribers of equal priority")
+{
+    event::event<void()> e;
+    Recorder r1(1), r2(2), r3(3), r4(4);
+    order.clear();
+
+    e.attach(&Recorder::Record, r1, 5);
+    e.attach(&Recorder::Record, r2);
+    e.attach<&Recorder::Record>(r3, 5);
+    e.attach(&Recorder::Record, &r4);
+
+    e();
+
+    REQUIRE(order == std::vector<int>{ 1, 3, 2, 4 });
+}
+
+TEST_CASE("event should keep priority order after detaching subscribers")
+{
+    event::small_event<void(), 2> e;
+    Recorder r1(1), r2(2), r3(3), r4(4);
+    order.clear();
+
+    auto h = e.attach(&Recorder::Record, r2, 1);
+    e.attach(&Recorder::Record, r4);
+    e.detach(h);
+    e.attach(&Recorder::Record, r1, 2);
+    e.attach(&Recorder::Record, r3, 1);
+    e.detach(&Recorder::Record, r4);
+    e.attach(&Recorder::Record, r4, -1);
+
+    e();
+
+    REQUIRE(order == std::vector<int>{ 1, 3, 4 });
+    REQUIRE(e.detach(e.attach<&Logger>(3)));
+}
+
+TEST_CASE("event should order subscribers attached during dispatch once dispatch returns")
+{
+    event::event<void()> e;
+    Recorder r1(1), r2(2);
+    bool attached = false;
+    order.clear();
+
+    struct Attacher
+    {
+        event::event<void()>& e;
+        Recorder& r;
+        bool& attached;
+
+        void Attach()
+        {
+            order.push_back(0);
+
+            if (!attached)
+            {
+                attached = true;
+                e.attach(&Recorder::Record, r, 10);
+            }
+        }
+    } a{ e, r1, attached };
+
+    e.attach(&Attacher::Attach, a);
+    e.attach(&Recorder::Record, r2);
+
+    e();
+
+    REQUIRE(order == std::vector<int>{ 0, 2 });
+
+    order.clear();
+    e();
+
+    REQUIRE(order == std::vector<int>{ 1, 0, 2 });
+}
+
+TEST_CASE("concurrent_event should notify subscribers with higher priority first")
+{
+    event::concurrent_event<void()> e;
+    order.clear();
+
+    e.attach<&Logger>(-1);
+    e.attach(&Metrics);
+    auto h = e.attach(&Router, 1);
+    e.attach(&Router, 1);
+
+    e();
+
+    REQUIRE(order == std::vector<int>{ 1, 1, 2, 3 });
+    REQUIRE(e.detach(h));
+}
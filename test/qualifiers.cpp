@@ -0,0 +1,159 @@
+#include <eventcpp/event.hpp>
+
+#include <type_traits>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class Sensor
+    {
+    public:
+        int offset;
+
+        Sensor(int o) : offset(o) {}
+
+        int Read(int x) const
+        {
+            return x + offset;
+        }
+
+        int Scale(int x) noexcept
+        {
+            return x * offset;
+        }
+
+        int Peek(int x) const noexcept
+        {
+            return x - offset;
+        }
+
+        int Lvalue(int x) &
+        {
+            return x + 2 * offset;
+        }
+
+        int ConstLvalue(int x) const&
+        {
+            return x + 3 * offset;
+        }
+    };
+
+    int Safe(int x) noexcept
+    {
+        return x + 1;
+    }
+
+    int Unsafe(int x)
+    {
+        return x + 2;
+    }
+
+    template<typename TEvent, typename TFunc, typename = void>
+    struct can_attach : std::false_type
+    {
+    };
+
+    template<typename TEvent, typename TFunc>
+    struct can_attach<TEvent, TFunc, std::void_t<decltype(std::declval<TEvent&>().attach(std::declval<TFunc>()))>>
+        : std::true_type
+    {
+    };
+}
+
+TEST_CASE("event should notify const, noexcept and ref-qualified member functions")
+{
+    event::event<int (int)> e;
+    Sensor s(10);
+    const Sensor cs(100);
+
+    SECTION("const member function")
+    {
+        e.attach(&Sensor::Read, s);
+        REQUIRE(e(1) == 11);
+
+        e.detach(&Sensor::Read, s);
+        REQUIRE(e.empty());
+    }
+    SECTION("const member function on a const object")
+    {
+        e.attach(&Sensor::Read, cs);
+        REQUIRE(e(1) == 101);
+
+        e.detach(&Sensor::Read, &cs);
+        REQUIRE(e.empty());
+    }
+    SECTION("noexcept member function")
+    {
+        e.attach(&Sensor::Scale, &s);
+        REQUIRE(e(2) == 20);
+
+        e.detach(&Sensor::Scale, s);
+        REQUIRE(e.empty());
+    }
+    SECTION("ref-qualified member functions")
+    {
+        e.attach(&Sensor::Lvalue, s);
+        REQUIRE(e(1) == 21);
+
+        e.attach(&Sensor::ConstLvalue, cs, 1);
+        REQUIRE(e(1) == 21);
+
+        e.detach(&Sensor::Lvalue, s);
+        REQUIRE(e(1) == 301);
+    }
+    SECTION("member functions bound at compile time")
+    {
+        e.attach<&Sensor::Peek>(cs);
+        REQUIRE(e(1) == -99);
+
+        e.attach<&Sensor::Scale>(s);
+        REQUIRE(e(1) == 10);
+
+        e.detach<&Sensor::Scale>(&s);
+        e.detach<&Sensor::Peek>(cs);
+        REQUIRE(e.empty());
+    }
+}
+
+TEST_CASE("event should be notified through a const reference")
+{
+    event::event<int (int)> e;
+    const auto& ce = e;
+
+    e.attach(Unsafe);
+
+    REQUIRE(ce(1) == 3);
+    REQUIRE(ce.dispatch<event::until_true>(1) == 3);
+}
+
+TEST_CASE("noexcept event should accept only subscribers that do not throw")
+{
+    event::event<int (int) noexcept> e;
+    event::small_event<void (int) noexcept, 2> small;
+    Sensor s(10);
+    int total = 0;
+
+    static_assert(noexcept(e(1)), "notifying a noexcept event must not throw");
+    static_assert(noexcept(small(1)), "notifying a noexcept event must not throw");
+    static_assert(!noexcept(std::declval<event::event<int (int)>&>()(1)), "notifying an event may throw");
+
+    static_assert(can_attach<decltype(e), int (*)(int) noexcept>::value, "noexcept function must attach");
+    static_assert(!can_attach<decltype(e), int (*)(int)>::value, "throwing function must not attach");
+    static_assert(!can_attach<decltype(small), void (*)(int)>::value, "throwing function must not attach");
+
+    e.attach(Safe);
+    e.attach(&Sensor::Scale, s);
+    e.attach<&Sensor::Peek>(s, 1);
+    small.attach([&total](int x) noexcept { total += x; });
+
+    REQUIRE(e(2) == 20);
+
+    e.detach(Safe);
+    e.detach(&Sensor::Scale, s);
+    REQUIRE(e(2) == -8);
+
+    small(5);
+    REQUIRE(total == 5);
+}
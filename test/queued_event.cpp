@@ -0,0 +1,120 @@
+#include <eventcpp/queued_event.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("queued_event should deliver enqueued notifications in order on drain")
+{
+    event::queued_event<void (int, const std::string&)> e(4);
+    std::vector<std::string> received;
+
+    e.attach([&received](int x, const std::string& s) { received.push_back(std::to_string(x) + s); });
+
+    REQUIRE(e.capacity() == 4);
+    REQUIRE(e.drain() == 0);
+
+    std::string text = "a";
+    REQUIRE(e.enqueue(1, text));
+    text = "b";
+    REQUIRE(e.enqueue(2, text));
+    REQUIRE(e.enqueue(3, "c"));
+    REQUIRE(e.enqueue(4, "d"));
+    REQUIRE_FALSE(e.enqueue(5, "e"));
+
+    REQUIRE(e.drain(3) == 3);
+    REQUIRE(received == std::vector<std::string>{ "1a", "2b", "3c" });
+
+    REQUIRE(e.enqueue(5, "e"));
+    REQUIRE(e.drain() == 2);
+    REQUIRE(received.size() == 5);
+    REQUIRE(received.back() == "5e");
+}
+
+TEST_CASE("queued_event should destroy notifications that were never drained")
+{
+    auto payload = std::make_shared<int>(1);
+
+    {
+        event::queued_event<void (std::shared_ptr<int>)> e(3);
+
+        REQUIRE(e.capacity() == 4);
+        REQUIRE(e.enqueue(payload));
+        REQUIRE(e.enqueue(payload));
+        REQUIRE(payload.use_count() == 3);
+    }
+
+    REQUIRE(payload.use_count() == 1);
+}
+
+TEST_CASE("queued_event should free a notification whose subscriber throws")
+{
+    event::queued_event<void (int)> e(2);
+    int calls = 0;
+
+    e.attach([&calls](int x)
+    {
+        calls++;
+
+        if (x == 1)
+            throw std::runtime_error("rejected");
+    });
+
+    REQUIRE(e.enqueue(1));
+    REQUIRE(e.enqueue(2));
+    REQUIRE_THROWS_AS(e.drain(), std::runtime_error);
+    REQUIRE(e.enqueue(3));
+    REQUIRE(e.drain() == 2);
+    REQUIRE(calls == 3);
+}
+
+TEST_CASE("queued_event should deliver notifications enqueued from many threads")
+{
+    constexpr int producers = 4;
+    constexpr int per_producer = 20000;
+
+    event::queued_event<void (int, int)> e(256);
+    std::vector<int> next(producers, 0);
+    bool ordered = true;
+    int received = 0;
+
+    e.attach([&](int producer, int sequence)
+    {
+        ordered = ordered && next[producer] == sequence;
+        next[producer] = sequence + 1;
+        received++;
+    });
+
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&e, p]
+        {
+            for (int i = 0; i < per_producer; i++)
+            {
+                while (!e.enqueue(p, i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    while (received < producers * per_producer)
+    {
+        if (e.drain(64) == 0)
+            std::this_thread::yield();
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    REQUIRE(ordered);
+    REQUIRE(e.drain() == 0);
+}
@@ -0,0 +1,226 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/recording.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Quote
+    {
+        int instrument;
+        double price;
+    };
+
+    class Book
+    {
+    public:
+        std::vector<int> instruments;
+        double total = 0;
+
+        void Update(const Quote& q, std::size_t size)
+        {
+            instruments.push_back(q.instrument);
+            total += q.price * static_cast<double>(size);
+        }
+    };
+
+    struct manual_clock
+    {
+        using duration = std::chrono::nanoseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<manual_clock>;
+
+        static constexpr bool is_steady = true;
+
+        static inline time_point current{};
+
+        static time_point now() noexcept
+        {
+            return current;
+        }
+    };
+}
+
+TEST_CASE("recorded notifications should be replayed into the same subscribers")
+{
+    event::event<void (const Quote&, std::size_t)> e;
+    std::vector<std::byte> log(1024);
+    event::recorder<void (const Quote&, std::size_t)> rec(log);
+    Book live;
+
+    e.attach(&Book::Update, live);
+    rec.attach_to(e);
+
+    e(Quote{ 1, 2.5 }, 2);
+    e(Quote{ 7, 1.0 }, 3);
+    e(Quote{ 4, 0.5 }, 4);
+
+    REQUIRE(rec.size() == 3);
+    REQUIRE(rec.dropped() == 0);
+
+    event::event<void (const Quote&, std::size_t)> backtest;
+    Book replayed;
+
+    backtest.attach(&Book::Update, replayed);
+
+    event::replayer<void (const Quote&, std::size_t)> player(rec.data());
+
+    REQUIRE(player.replay(backtest) == 3);
+    REQUIRE(replayed.instruments == live.instruments);
+    REQUIRE(replayed.total == live.total);
+
+    REQUIRE(player.replay(backtest) == 3);
+    REQUIRE(replayed.instruments.size() == 6);
+}
+
+TEST_CASE("recorder should count notifications that do not fit in the log")
+{
+    using record_size = std::integral_constant<std::size_t, sizeof(std::int64_t) + sizeof(int)>;
+
+    event::event<void (int)> e;
+    std::vector<std::byte> log(sizeof(event::details::log_header) + 2 * record_size::value + 1);
+    event::recorder<void (int)> rec(log);
+
+    rec.attach_to(e);
+
+    e(1);
+    e(2);
+    e(3);
+
+    REQUIRE(rec.capacity() == 2);
+    REQUIRE(rec.size() == 2);
+    REQUIRE(rec.dropped() == 1);
+
+    std::vector<int> values;
+    event::event<void (int)> target;
+
+    target.attach([&values](int v) { values.push_back(v); });
+
+    event::replayer<void (int)>(rec.data()).replay(target);
+
+    REQUIRE(values == std::vector<int>{ 1, 2 });
+}
+
+TEST_CASE("replayer should reject logs of other signatures")
+{
+    std::vector<std::byte> log(256);
+    event::recorder<void (int)> rec(log);
+
+    REQUIRE_THROWS_AS(event::replayer<void (double)>(rec.data()), std::invalid_argument);
+    REQUIRE_THROWS_AS(event::replayer<void (int, int)>(rec.data()), std::invalid_argument);
+    REQUIRE_NOTHROW(event::replayer<void (const int&)>(rec.data()));
+
+    std::vector<std::byte> garbage(256, std::byte{ 0x5a });
+
+    REQUIRE_THROWS_AS(event::replayer<void (int)>(garbage), std::invalid_argument);
+
+    std::vector<std::byte> tiny(4);
+
+    REQUIRE_THROWS_AS(event::recorder<void (int)>(tiny), std::length_error);
+}
+
+TEST_CASE("replayer should pace notifications by their timestamps")
+{
+    using namespace std::chrono_literals;
+
+    event::event<void (int)> e;
+    std::vector<std::byte> log(256);
+    event::recorder<void (int), manual_clock> rec(log);
+
+    rec.attach_to(e);
+
+    manual_clock::current = manual_clock::time_point(1s);
+    e(1);
+    manual_clock::current += 10ms;
+    e(2);
+    manual_clock::current += 20ms;
+    e(3);
+
+    event::replayer<void (int)> player(rec.data());
+
+    REQUIRE(player.duration() == 30ms);
+
+    std::vector<std::chrono::steady_clock::time_point> times;
+    event::event<void (int)> target;
+
+    target.attach([&times](int) { times.push_back(std::chrono::steady_clock::now()); });
+
+    auto start = std::chrono::steady_clock::now();
+
+    REQUIRE(player.replay_paced(target, 2.0) == 3);
+    REQUIRE(times[1] - start >= 5ms);
+    REQUIRE(times[2] - start >= 15ms);
+}
+
+#ifdef EVENTCPP_MAPPED_FILES
+TEST_CASE("log recorded into a mapped file should be replayed after reopening it")
+{
+    auto path = (std::filesystem::temp_directory_path() / "eventcpp_recording_test.log").string();
+
+    {
+        event::mapped_file file(path.c_str(), 4096);
+        event::event<void (int, double) noexcept> e;
+        event::recorder<void (int, double)> rec(file.writable_data());
+
+        rec.attach_to(e);
+
+        for (int i = 0; i < 100; i++)
+        {
+            e(i, i * 0.5);
+        }
+    }
+
+    const event::mapped_file file(path.c_str());
+    event::replayer<void (int, double)> player(file.data());
+    event::event<void (int, double)> target;
+    int count = 0;
+    double total = 0;
+
+    target.attach([&](int i, double d) { count++; total += i + d; });
+
+    REQUIRE(player.replay(target) == 100);
+    REQUIRE(count == 100);
+    REQUIRE(total == 4950 * 1.5);
+
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(event::mapped_file(path.c_str()), std::system_error);
+}
+
+TEST_CASE("log should be replayed through a read-only mapped file that is not const")
+{
+    auto path = (std::filesystem::temp_directory_path() / "eventcpp_recording_readonly_test.log").string();
+
+    {
+        event::mapped_file file(path.c_str(), 4096);
+        event::event<void (int, double) noexcept> e;
+        event::recorder<void (int, double)> rec(file.writable_data());
+
+        rec.attach_to(e);
+        e(1, 2.5);
+        e(2, 3.5);
+    }
+
+    event::mapped_file file(path.c_str());
+    event::replayer<void (int, double)> player(file.data());
+    event::event<void (int, double)> target;
+    double total = 0;
+
+    target.attach([&](int i, double d) { total += i + d; });
+
+    REQUIRE(file.data().size() == 4096);
+    REQUIRE(player.replay(target) == 2);
+    REQUIRE(total == 9);
+    REQUIRE_THROWS_AS(file.writable_data(), std::logic_error);
+
+    std::filesystem::remove(path);
+}
+#endif
@@ -0,0 +1,290 @@
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class Subscriber
+    {
+    public:
+        event::event<void ()>* source = nullptr;
+        event::subscription victim;
+        int calls = 0;
+
+        void Count()
+        {
+            calls++;
+        }
+
+        void DetachVictim()
+        {
+            calls++;
+            source->detach(victim);
+        }
+    };
+
+    /**
+     * \brief Resource failing once a number of bytes has been allocated
+     */
+    class limited_resource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t budget;
+
+        explicit limited_resource(std::size_t b) : budget(b)
+        {
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            if (bytes > budget)
+                throw std::bad_alloc();
+
+            budget -= bytes;
+
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+TEST_CASE("event should allow subscribers to detach during dispatch")
+{
+    event::event<void ()> e;
+    Subscriber s1, s2, s3;
+    s1.source = s2.source = s3.source = &e;
+
+    SECTION("subscriber detaching itself")
+    {
+        s1.victim = e.attach(&Subscriber::DetachVictim, s1);
+        e.attach(&Subscriber::Count, s2);
+
+        e();
+        e();
+        REQUIRE(s1.calls == 1);
+        REQUIRE(s2.calls == 2);
+        REQUIRE(e.size() == 1);
+    }
+    SECTION("subscriber detaching a later subscriber")
+    {
+        e.attach(&Subscriber::DetachVictim, s1);
+        s1.victim = e.attach(&Subscriber::Count, s2);
+        e.attach(&Subscriber::Count, s3);
+
+        e();
+        REQUIRE(s2.calls == 0);
+        REQUIRE(s3.calls == 1);
+    }
+    SECTION("subscriber detaching an earlier subscriber")
+    {
+        s2.victim = e.attach(&Subscriber::Count, s1);
+        e.attach(&Subscriber::DetachVictim, s2);
+
+        e();
+        e();
+        REQUIRE(s1.calls == 1);
+        REQUIRE(s2.calls == 2);
+    }
+    SECTION("many subscribers detached during one dispatch")
+    {
+        std::vector<Subscriber> subscribers(40);
+
+        for (auto& s : subscribers)
+        {
+            s.source = &e;
+            s.victim = e.attach(&Subscriber::DetachVictim, s);
+        }
+
+        e();
+        REQUIRE(e.empty());
+
+        for (const auto& s : subscribers)
+        {
+            REQUIRE(s.calls == 1);
+        }
+
+        e.attach(&Subscriber::Count, s1);
+        e();
+        REQUIRE(s1.calls == 1);
+    }
+}
+
+TEST_CASE("event should notify subscribers attached during dispatch from the next notification")
+{
+    SECTION("subscriber attaching while the inline storage is full")
+    {
+        event::small_event<void (), 2> e;
+        std::vector<event::subscription> attached;
+        int calls = 0;
+
+        e.attach([&e, &attached, &calls]()
+        {
+            while (calls == 0 && attached.size() < 8)
+            {
+                attached.push_back(e.attach([&calls]() { calls++; }));
+            }
+
+            // storage of this subscriber must not have moved
+            calls += 100;
+        });
+
+        e();
+        REQUIRE(calls == 100);
+        REQUIRE(e.size() == 9);
+
+        for (auto handle : attached)
+        {
+            REQUIRE(e.detach(handle));
+        }
+
+        e();
+        REQUIRE(calls == 200);
+        REQUIRE(e.size() == 1);
+    }
+    SECTION("subscriber detaching a subscriber attached in the same dispatch")
+    {
+        event::event<void ()> e;
+        Subscriber s1, s2;
+        s1.source = &e;
+
+        e.attach([&e, &s1, &s2]()
+        {
+            if (!s1.victim.valid())
+            {
+                s1.victim = e.attach(&Subscriber::Count, s2);
+                e.attach(&Subscriber::DetachVictim, s1, 1);
+                e.detach(&Subscriber::DetachVictim, s1);
+                e.detach(s1.victim);
+            }
+        });
+
+        e();
+        e();
+        REQUIRE(s1.calls == 0);
+        REQUIRE(s2.calls == 0);
+        REQUIRE(e.size() == 1);
+    }
+    SECTION("nested dispatch attaching with a higher priority")
+    {
+        event::event<int (int)> e;
+        std::vector<int> order;
+
+        e.attach([&e, &order](int depth)
+        {
+            order.push_back(depth);
+
+            if (depth == 0)
+            {
+                e(1);
+                e.attach([&order](int) { order.push_back(-1); return 0; }, 5);
+            }
+
+            return depth;
+        });
+
+        REQUIRE(e(0) == 0);
+        REQUIRE(order == std::vector<int>{ 0, 1 });
+
+        order.clear();
+        e(1);
+        REQUIRE(order == std::vector<int>{ -1, 1 });
+    }
+}
+
+TEST_CASE("event should place subscribers attached before an allocation failure during dispatch")
+{
+    limited_resource resource(4096);
+    event::event<void ()> e(&resource);
+    std::vector<event::subscription> attached;
+    std::size_t calls = 0;
+    bool attaching = true;
+
+    e.attach([&e, &attached, &calls, &attaching]()
+    {
+        if (!std::exchange(attaching, false))
+            return;
+
+        for (;;)
+        {
+            attached.push_back(e.attach([&calls]() { calls++; }));
+        }
+    });
+
+    // placing the pending subscribers fails as well once the dispatch returns
+    REQUIRE_THROWS_AS(e(), std::bad_alloc);
+    REQUIRE(!attached.empty());
+    REQUIRE(e.size() == attached.size() + 1);
+
+    resource.budget = 1 << 20;
+
+    e();
+    calls = 0;
+    e();
+    REQUIRE(calls == attached.size());
+
+    for (auto handle : attached)
+    {
+        REQUIRE(e.detach(handle));
+    }
+
+    REQUIRE(e.size() == 1);
+}
+
+TEST_CASE("subscriber stored inline should keep running while attaching during dispatch")
+{
+    event::event<void ()> e;
+    int count = 0;
+    auto subscriber = [&e, &count]() { e.attach([]() {}); count++; };
+
+    static_assert(event::details::delegate<void ()>::stores_inline<decltype(subscriber)>, "lambda should be stored inline");
+
+    e.attach(subscriber);
+
+    for (int i = 0; i < 100; i++)
+    {
+        e();
+    }
+
+    REQUIRE(count == 100);
+    REQUIRE(e.size() == 101);
+}
+
+TEST_CASE("subscriber replacing itself during dispatch should be detached by its handle")
+{
+    event::event<void ()> e;
+    event::subscription first, second;
+    int calls = 0;
+
+    e.attach([&calls] { calls++; });
+    first = e.attach([&]
+    {
+        e.detach(first);
+        second = e.attach([&] { e.detach(second); });
+    });
+
+    e();
+    REQUIRE(e.size() == 2);
+
+    e();
+    REQUIRE(e.size() == 1);
+    REQUIRE_FALSE(e.detach(second));
+
+    e();
+    REQUIRE(calls == 3);
+}
@@ -0,0 +1,90 @@
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    struct Order
+    {
+        int quantity;
+    };
+
+    class Check
+    {
+    public:
+        int limit;
+        int calls = 0;
+
+        Check(int l) : limit(l) {}
+
+        event::dispatch_result Validate(const Order& order)
+        {
+            calls++;
+            return order.quantity > limit ? event::dispatch_result::stop : event::dispatch_result::proceed;
+        }
+
+        bool Accept(const Order& order)
+        {
+            calls++;
+            return order.quantity <= limit;
+        }
+    };
+}
+
+TEST_CASE("event should stop dispatch when a subscriber returns stop")
+{
+    event::event<event::dispatch_result (const Order&)> e;
+    Check c1(100), c2(10), c3(1000);
+
+    e.attach(&Check::Validate, c1);
+    e.attach(&Check::Validate, c2);
+    e.attach(&Check::Validate, c3);
+
+    SECTION("rejected order")
+    {
+        REQUIRE(e(Order{ 50 }) == event::dispatch_result::stop);
+        REQUIRE(c1.calls == 1);
+        REQUIRE(c2.calls == 1);
+        REQUIRE(c3.calls == 0);
+    }
+    SECTION("accepted order")
+    {
+        REQUIRE(e(Order{ 5 }) == event::dispatch_result::proceed);
+        REQUIRE(c3.calls == 1);
+    }
+    SECTION("no subscribers")
+    {
+        event::event<event::dispatch_result (const Order&)> none;
+
+        REQUIRE(none(Order{ 5 }) == event::dispatch_result::proceed);
+    }
+}
+
+TEST_CASE("event should stop dispatch according to a policy")
+{
+    event::event<bool (const Order&)> e;
+    Check c1(100), c2(10), c3(1000);
+
+    e.attach(&Check::Accept, c1);
+    e.attach(&Check::Accept, c2);
+    e.attach(&Check::Accept, c3);
+
+    SECTION("until_false")
+    {
+        REQUIRE_FALSE(e.dispatch<event::until_false>(Order{ 50 }));
+        REQUIRE(c3.calls == 0);
+
+        REQUIRE(e.dispatch<event::until_false>(Order{ 5 }));
+        REQUIRE(c3.calls == 1);
+    }
+    SECTION("until_true")
+    {
+        REQUIRE(e.dispatch<event::until_true>(Order{ 50 }));
+        REQUIRE(c2.calls == 0);
+    }
+    SECTION("plain notification runs every subscriber")
+    {
+        REQUIRE(e(Order{ 50 }));
+        REQUIRE(c3.calls == 1);
+    }
+}
@@ -0,0 +1,74 @@
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    int Inc(int val)
+    {
+        return val + 1;
+    }
+
+    int Dec(int val)
+    {
+        return val - 1;
+    }
+
+    class Counter
+    {
+    public:
+        int calls = 0;
+
+        int Count(int val)
+        {
+            calls++;
+            return val;
+        }
+    };
+}
+
+TEST_CASE("small_event should notify subscribers stored inline and on the heap")
+{
+    event::small_event<int (int), 2> e;
+    Counter c1, c2, c3;
+
+    SECTION("subscribers within inline capacity")
+    {
+        e.attach(&Counter::Count, c1);
+        e.attach(Inc);
+
+        REQUIRE(e(5) == 6);
+        REQUIRE(c1.calls == 1);
+    }
+    SECTION("subscribers spilled to the heap")
+    {
+        e.attach(&Counter::Count, c1);
+        e.attach(&Counter::Count, c2);
+        e.attach(&Counter::Count, c3);
+        e.attach(Dec);
+
+        REQUIRE(e(5) == 4);
+        REQUIRE(c1.calls == 1);
+        REQUIRE(c2.calls == 1);
+        REQUIRE(c3.calls == 1);
+    }
+    SECTION("detach after spilling to the heap")
+    {
+        e.attach(&Counter::Count, c1);
+        e.attach(&Counter::Count, c2);
+        e.attach(Inc);
+        e.detach(Inc);
+
+        REQUIRE(e(5) == 5);
+        REQUIRE(c2.calls == 1);
+    }
+    SECTION("copied event keeps its subscribers")
+    {
+        e.attach(&Counter::Count, c1);
+        e.attach(Inc);
+
+        auto copy = e;
+        REQUIRE(copy(1) == 2);
+        REQUIRE(c1.calls == 1);
+    }
+}
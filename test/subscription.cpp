@@ -0,0 +1,134 @@
+#include <array>
+
+#include <eventcpp/event.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    std::array<int, 4> calls;
+
+    void First()
+    {
+        calls[0]++;
+    }
+
+    void Second()
+    {
+        calls[1]++;
+    }
+
+    class Listener
+    {
+        int _idx;
+
+    public:
+        Listener(int idx) : _idx(idx) {}
+
+        void Notify()
+        {
+            calls[_idx]++;
+        }
+    };
+}
+
+TEST_CASE("event should detach subscribers by handle")
+{
+    event::event<void ()> e;
+    calls = { 0, 0, 0, 0 };
+    Listener l2(2), l3(3);
+
+    auto h0 = e.attach(First);
+    auto h1 = e.attach(Second);
+    auto h2 = e.attach(&Listener::Notify, l2);
+    auto h3 = e.attach(&Listener::Notify, l3);
+
+    REQUIRE(e.size() == 4);
+
+    SECTION("detached subscriber is not notified")
+    {
+        REQUIRE(e.detach(h2));
+        e();
+
+        std::array<int, 4> expected = { 1, 1, 0, 1 };
+        REQUIRE(calls == expected);
+        REQUIRE(e.size() == 3);
+    }
+    SECTION("stale handle is ignored")
+    {
+        REQUIRE(e.detach(h0));
+        REQUIRE_FALSE(e.detach(h0));
+
+        auto h4 = e.attach(First);
+        REQUIRE_FALSE(e.detach(h0));
+        REQUIRE(h4 != h0);
+
+        e();
+        std::array<int, 4> expected = { 1, 1, 1, 1 };
+        REQUIRE(calls == expected);
+    }
+    SECTION("order is kept when removed slots are compacted")
+    {
+        REQUIRE(e.detach(h0));
+        REQUIRE(e.detach(h1));
+        REQUIRE(e.detach(h3));
+        e.attach(First);
+
+        e();
+        std::array<int, 4> expected = { 1, 0, 1, 0 };
+        REQUIRE(calls == expected);
+        REQUIRE(e.detach(h2));
+        REQUIRE(e.size() == 1);
+    }
+    SECTION("default handle is not valid")
+    {
+        event::subscription handle;
+
+        REQUIRE_FALSE(handle.valid());
+        REQUIRE_FALSE(e.detach(handle));
+        REQUIRE(h1.valid());
+    }
+}
+
+TEST_CASE("scoped_subscription should detach subscriber on destruction")
+{
+    event::event<void ()> e;
+    calls = { 0, 0, 0, 0 };
+
+    {
+        event::scoped_subscription scoped(e, e.attach(First));
+        e();
+    }
+
+    e();
+    REQUIRE(calls[0] == 1);
+    REQUIRE(e.empty());
+
+    SECTION("released subscription stays attached")
+    {
+        event::subscription handle;
+
+        {
+            event::scoped_subscription scoped(e, e.attach(Second));
+            handle = scoped.release();
+        }
+
+        e();
+        REQUIRE(calls[1] == 1);
+        REQUIRE(e.detach(handle));
+    }
+    SECTION("moved subscription is detached once")
+    {
+        event::scoped_subscription outer;
+
+        {
+            event::scoped_subscription scoped(e, e.attach(Second));
+            outer = std::move(scoped);
+        }
+
+        e();
+        outer.reset();
+        e();
+        REQUIRE(calls[1] == 1);
+    }
+}
@@ -0,0 +1,211 @@
+#include <eventcpp/event.hpp>
+#include <eventcpp/concurrent_event.hpp>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    class Listener : public event::tracked
+    {
+    public:
+        int* calls;
+
+        Listener(int* c) : calls(c) {}
+
+        int Handle(int x)
+        {
+            (*calls)++;
+            return x;
+        }
+
+        int Peek(int x) const
+        {
+            (*calls)++;
+            return -x;
+        }
+    };
+
+    class Plain
+    {
+    public:
+        int calls = 0;
+
+        int Handle(int x)
+        {
+            calls++;
+            return x;
+        }
+    };
+}
+
+TEST_CASE("event should drop subscribers of destroyed tracked objects")
+{
+    event::event<int (int)> e;
+    int calls = 0;
+    Plain p;
+
+    e.attach(&Plain::Handle, p);
+
+    {
+        Listener l1(&calls);
+        const Listener l2(&calls);
+
+        e.attach(&Listener::Handle, l1);
+        e.attach<&Listener::Peek>(l2, -1);
+        e.attach(&Listener::Peek, &l2, 1);
+
+        REQUIRE(e(2) == -2);
+        REQUIRE(calls == 3);
+        REQUIRE(e.size() == 4);
+    }
+
+    REQUIRE(e(3) == 3);
+    REQUIRE(calls == 3);
+    REQUIRE(p.calls == 2);
+    REQUIRE(e.size() == 1);
+}
+
+TEST_CASE("event should drop expired tracked subscribers once a dispatch skipped them")
+{
+    event::event<int (int)> e;
+    int calls = 0;
+    event::subscription handle;
+
+    {
+        Listener l(&calls);
+        handle = e.attach(&Listener::Handle, l);
+    }
+
+    // nothing looks at the tracked object until the event is notified
+    REQUIRE(e.size() == 1);
+
+    e(1);
+    REQUIRE(calls == 0);
+    REQUIRE(e.size() == 0);
+    REQUIRE_FALSE(e.detach(handle));
+    REQUIRE(e.empty());
+}
+
+TEST_CASE("const event should skip expired tracked subscribers from several threads")
+{
+    event::event<int (int)> e;
+    std::atomic<int> sum{ 0 };
+    int calls = 0;
+
+    e.attach([&sum](int x) { sum += x; return x; });
+
+    {
+        Listener l(&calls);
+        e.attach(&Listener::Handle, l);
+    }
+
+    const auto& notifier = e;
+    auto fire = [&notifier]()
+    {
+        for (int i = 0; i < 1000; i++)
+            notifier(1);
+    };
+
+    std::thread first(fire);
+    std::thread second(fire);
+
+    first.join();
+    second.join();
+
+    REQUIRE(sum == 2000);
+    REQUIRE(calls == 0);
+    REQUIRE(e.size() == 1);
+
+    e.attach([](int x) { return x; });
+
+    REQUIRE(e.size() == 2);
+}
+
+TEST_CASE("event should keep subscribers of copied tracked objects apart")
+{
+    event::event<int (int)> e;
+    int calls = 0;
+    std::optional<Listener> original(std::in_place, &calls);
+
+    e.attach(&Listener::Handle, *original);
+    Listener copy = *original;
+    original.reset();
+
+    REQUIRE(e(1) == 0);
+    REQUIRE(calls == 0);
+
+    e.attach(&Listener::Handle, copy);
+    REQUIRE(e(1) == 1);
+    REQUIRE(calls == 1);
+
+    e.detach(&Listener::Handle, copy);
+    REQUIRE(e.empty());
+}
+
+TEST_CASE("event should drop subscribers of objects owned by an expired shared_ptr")
+{
+    event::event<int (int)> e;
+    auto p = std::make_shared<Plain>();
+    std::weak_ptr<Plain> weak = p;
+
+    auto handle = e.attach(&Plain::Handle, weak);
+    e.attach<&Plain::Handle>(weak, 1);
+
+    REQUIRE(e(5) == 5);
+    REQUIRE(p->calls == 2);
+
+    auto copy = e;
+
+    p.reset();
+    REQUIRE(e(5) == 0);
+    REQUIRE(e.empty());
+    REQUIRE_FALSE(e.detach(handle));
+
+    REQUIRE(copy(5) == 0);
+    REQUIRE(copy.empty());
+
+    REQUIRE_THROWS_AS(e.attach(&Plain::Handle, weak), std::bad_weak_ptr);
+}
+
+TEST_CASE("tracked subscribers may be detached and destroyed during dispatch")
+{
+    event::small_event<void (int), 2> e;
+    int calls = 0;
+    auto l = std::make_unique<Listener>(&calls);
+
+    e.attach([&l](int) { l.reset(); }, 1);
+    e.attach<&Listener::Handle>(*l);
+
+    e(1);
+    e(1);
+
+    REQUIRE(calls == 0);
+    REQUIRE(e.size() == 1);
+}
+
+TEST_CASE("concurrent_event should skip subscribers of destroyed tracked objects")
+{
+    event::concurrent_event<int (int)> e;
+    int calls = 0;
+    Plain p;
+
+    {
+        Listener l(&calls);
+        e.attach(&Listener::Handle, l, 1);
+        e.attach(&Plain::Handle, p);
+
+        REQUIRE(e(1) == 1);
+        REQUIRE(calls == 1);
+    }
+
+    REQUIRE(e(2) == 2);
+    REQUIRE(calls == 1);
+
+    e.attach(&Plain::Handle, p);
+    REQUIRE(e.size() == 2);
+}